@@ -18,6 +18,15 @@ extern "C" {
 
 BQN_EXP void bqn_init(void); // must be called at least once before any of the below functions are used; can safely be called multiple times
 
+// Separate interpreters, for running BQN concurrently on multiple threads; only functional if CBQN was built with MULTI_INSTANCE=1 (otherwise bqn_newInstance & bqn_currentInstance give NULL)
+// Every thread has a current instance, which all other functions called on that thread operate on; initially that's the thread's own default one, initialized by bqn_init
+// An instance can only be used on the thread that created it, and BQNV values can only be used in the instance they come from
+typedef struct bqn_instance bqn_instance;
+BQN_EXP bqn_instance* bqn_newInstance(void); // create and initialize a new instance, without entering it
+BQN_EXP bqn_instance* bqn_currentInstance(void); // the instance currently entered on this thread
+BQN_EXP void bqn_enter(bqn_instance* i); // make i the current instance of this thread; the previous one keeps its state, and can be re-entered later
+BQN_EXP void bqn_freeInstance(bqn_instance* i); // free i along with its heap; if it was the current one, the thread is left with a new uninitialized default instance
+
 BQN_EXP void bqn_free(BQNV v); // free a previously obtained BQNV value, making it illegal to use it further
 BQN_EXP BQNV bqn_copy(BQNV v); // create a BQNV with a value equivalent to `v`, which can be freed separately from `v`
 
@@ -129,10 +129,11 @@ static B modint_AS(B w,   B xv) { return modint_AA(w, C2(shape, C1(fne, incG(w))
   #define PI8(N)  i8*  N##p = i8any_ptr (N);
   #define PI16(N) i16* N##p = i16any_ptr(N);
   #define PI32(N) i32* N##p = i32any_ptr(N);
-  #define Ri8(A)  i8*  rp; r=m_i8arrc (&rp, A);
-  #define Ri16(A) i16* rp; r=m_i16arrc(&rp, A);
-  #define Ri32(A) i32* rp; r=m_i32arrc(&rp, A);
+  #define Ri8(A)  i8*  rp; if (intReuse) rp=m_tyarrlbcR(&r, 3, A, A, t_i8arr);  else r=m_i8arrc (&rp, A);
+  #define Ri16(A) i16* rp; if (intReuse) rp=m_tyarrlbcR(&r, 4, A, A, t_i16arr); else r=m_i16arrc(&rp, A);
+  #define Ri32(A) i32* rp; if (intReuse) rp=m_tyarrlbcR(&r, 5, A, A, t_i32arr); else r=m_i32arrc(&rp, A);
   #define Rf64(A) f64* rp; r=m_f64arrc(&rp, A);
+  #define Rf64R(X,Y) f64* rp = m_tyarrlbcR(&r, 6, X, Y, t_f64arr); // f64 loops never restart, so can always write over an unshared argument
   #define DOF(EXPR,A,W,X) { vfor (usz i = 0; i < ia; i++) { f64 wv=W; f64 xv=X; rp[i]=EXPR; } }
   #define DOI8(EXPR,A,W,X,BASE)  { Ri8(A)  for (usz i=0; i<ia; i++) { i16 wv=W; i16 xv=X; i16 rv=EXPR; if (RARE(rv!=( i8)rv)) { decG(r); goto BASE; } rp[i]=rv; } goto dec_ret; }
   #define DOI16(EXPR,A,W,X,BASE) { Ri16(A) for (usz i=0; i<ia; i++) { i32 wv=W; i32 xv=X; i32 rv=EXPR; if (RARE(rv!=(i16)rv)) { decG(r); goto BASE; } rp[i]=rv; } goto dec_ret; }
@@ -149,7 +150,7 @@ static B modint_AS(B w,   B xv) { return modint_AA(w, C2(shape, C1(fne, incG(w))
           if (we<=el_i32 && xe<=el_i32) { INT_AA; }               \
           if (we<el_i32) { w=taga(cpyI32Arr(w)); we=el_i32; } void* wp=tyany_ptr(w); \
           if (xe<el_i32) { x=taga(cpyI32Arr(x)); xe=el_i32; } void* xp=tyany_ptr(x); \
-          Rf64(x);                                                \
+          Rf64R(x, w);                                            \
           if (we==el_i32) { B w,x /*shadow*/;                     \
             if (xe==el_i32) { DECOR vfor (usz i = 0; i < ia; i++) { w.f=((i32*)wp)[i]; x.f=((i32*)xp)[i]; rp[i]=EXPR; } } \
             else            { DECOR vfor (usz i = 0; i < ia; i++) { w.f=((i32*)wp)[i]; x.f=((f64*)xp)[i]; rp[i]=EXPR; } } \
@@ -161,10 +162,10 @@ static B modint_AS(B w,   B xv) { return modint_AA(w, C2(shape, C1(fne, incG(w))
         }                                                         \
       } else if (isF64(w)&isArr(x)) { usz ia=IA(x); u8 xe=TI(x,elType); \
         if (elInt(xe)) {INT_SA Rf64(x); x=toI32Any(x); PI32(x) DECOR vfor (usz i=0; i<ia; i++) {B x/*shadow*/;x.f=xp[i];rp[i]=EXPR;} decG(x); return num_squeeze(r); } \
-        if (xe==el_f64){       Rf64(x);         PF(x)  FLT_SAI DECOR vfor (usz i=0; i<ia; i++) {B x/*shadow*/;x.f=xp[i];rp[i]=EXPR;} decG(x); return num_squeeze(r); } \
+        if (xe==el_f64){       Rf64R(x, x);     PF(x)  FLT_SAI DECOR vfor (usz i=0; i<ia; i++) {B x/*shadow*/;x.f=xp[i];rp[i]=EXPR;} decG(x); return num_squeeze(r); } \
       } else if (isF64(x)&isArr(w)) { usz ia=IA(w); u8 we=TI(w,elType); ANY_AS \
         if (elInt(we)) {INT_AS Rf64(w); w=toI32Any(w); PI32(w) DECOR vfor (usz i=0; i<ia; i++) {B w/*shadow*/;w.f=wp[i];rp[i]=EXPR;} decG(w); return num_squeeze(r); } \
-        if (we==el_f64){       Rf64(w);         PF(w)          DECOR vfor (usz i=0; i<ia; i++) {B w/*shadow*/;w.f=wp[i];rp[i]=EXPR;} decG(w); return num_squeeze(r); } \
+        if (we==el_f64){       Rf64R(w, w);     PF(w)          DECOR vfor (usz i=0; i<ia; i++) {B w/*shadow*/;w.f=wp[i];rp[i]=EXPR;} decG(w); return num_squeeze(r); } \
       }                                                           \
       P2(NAME)                                                    \
     }                                                             \
@@ -201,7 +202,7 @@ static B modint_AS(B w,   B xv) { return modint_AA(w, C2(shape, C1(fne, incG(w))
         }
         u64 mask = (mask0-1)*repeatNum[xe];
         usz bytes = IA(x)*elw;
-        u8* rp = m_tyarrc(&r, elw, x, el2t(xe));
+        u8* rp = m_tyarrlbcR(&r, elwBitLog(xe), x, x, el2t(xe));
         andBytes_fn(rp, tyany_ptr(x), mask, bytes);
         decG(x);
         if (wi32==2) return taga(cpyBitArr(r));
@@ -259,29 +260,39 @@ static B modint_AS(B w,   B xv) { return modint_AA(w, C2(shape, C1(fne, incG(w))
       if (xe==el_i8  && q_i8 (w)) { PI8 (x) i8  wc=o2iG(w); DOI8 (EXPR,x,wc,xp[i],sa8B ) } sa8B :; \
       if (xe==el_i16 && q_i16(w)) { PI16(x) i16 wc=o2iG(w); DOI16(EXPR,x,wc,xp[i],sa16B) } sa16B:; \
       if (xe==el_i32 && q_i32(w)) { PI32(x) i32 wc=o2iG(w); DOI32(EXPR,x,wc,xp[i],sa32B) } sa32B:; \
-      if (xe==el_f64) { Rf64(x) PF(x) DOF(EXPR,w,w.f,xp[i]) goto dec_ret; }
+      if (xe==el_f64) { Rf64R(x,x) PF(x) DOF(EXPR,w,w.f,xp[i]) goto dec_ret; }
     #define REG_AS(NAME, EXPR) \
       if (we==el_bit) return bit_sel1Fn(NAME##_c2,w,x,0); \
       if (we==el_i8  && q_i8 (x)) { PI8 (w) i8  xc=o2iG(x); DOI8 (EXPR,w,wp[i],xc,as8B ) } as8B :; \
       if (we==el_i16 && q_i16(x)) { PI16(w) i16 xc=o2iG(x); DOI16(EXPR,w,wp[i],xc,as16B) } as16B:; \
       if (we==el_i32 && q_i32(x)) { PI32(w) i32 xc=o2iG(x); DOI32(EXPR,w,wp[i],xc,as32B) } as32B:; \
-      if (we==el_f64) { Rf64(w) PF(w) DOF(EXPR,x,wp[i],x.f) goto dec_ret; }
+      if (we==el_f64) { Rf64R(w,w) PF(w) DOF(EXPR,x,wp[i],x.f) goto dec_ret; }
     
     static B bitAA0(B w, B x, usz ia) { UD; }
     static NOINLINE B bitAA1(B w, B x, usz ia) {
-      u64* rp; B r = m_bitarrc(&rp, x);
+      B r; u64* rp = m_tyarrlbcR(&r, 0, x, w, t_bitarr);
       u64* wp=bitany_ptr(w); u64* xp=bitany_ptr(x);
       vfor (usz i=0; i<BIT_N(ia); i++) rp[i] = wp[i]|xp[i];
       decG(w); decG(x); return r;
     }
     static NOINLINE B bitAA2(B w, B x, usz ia) {
-      u64* rp; B r = m_bitarrc(&rp, x);
+      B r; u64* rp = m_tyarrlbcR(&r, 0, x, w, t_bitarr);
       u64* wp=bitany_ptr(w); u64* xp=bitany_ptr(x);
       vfor (usz i=0; i<BIT_N(ia); i++) rp[i] = wp[i]&xp[i];
       decG(w); decG(x); return r;
     }
     
+    // ⌊ and ⌈ can't overflow, so their integer loops never restart and may write over an unshared argument
+    #define add_intReuse 0
+    #define sub_intReuse 0
+    #define mul_intReuse 0
+    #define and_intReuse 0
+    #define or_intReuse 0
+    #define floor_intReuse 1
+    #define ceil_intReuse 1
+    
     #define AR_I_AA(CHR, NAME, EXPR, BIT, EXTRA) NOINLINE B NAME##_AA(B t, B w, B x) { \
+      const bool intReuse = NAME##_intReuse;                     \
       ur wr=RNK(w); usz* xsh=SH(x);                              \
       ur xr=RNK(x); usz* wsh=SH(w); ur mr=wr<xr?wr:xr;           \
       if (!eqShPart(wsh, xsh, mr)) thrF(CHR ": Expected equal shape prefix (%H ≡ ≢𝕨, %H ≡ ≢𝕩)", w, x); \
@@ -301,8 +312,8 @@ static B modint_AS(B w,   B xv) { return modint_AA(w, C2(shape, C1(fne, incG(w))
       if ((we==el_i32|we==el_f64)&(xe==el_i32|xe==el_f64)) {     \
         bool wei = we==el_i32; bool xei = xe==el_i32;            \
         if (wei&xei) { PI32(w) PI32(x)     DOI32(EXPR,w,wp[i],xp[i],rcf64) } \
-        if (!wei&!xei) { PF(w) PF(x) Rf64(x) DOF(EXPR,w,wp[i],xp[i]) goto dec_ret; } \
-        rcf64:; Rf64(x)                                          \
+        if (!wei&!xei) { PF(w) PF(x) Rf64R(x,w) DOF(EXPR,w,wp[i],xp[i]) goto dec_ret; } \
+        rcf64:; Rf64R(x,w)                                       \
         if (wei) { PI32(w)                                       \
           if (xei) { PI32(x) DOF(EXPR,w,wp[i],xp[i]) }           \
           else     { PF(x)   DOF(EXPR,w,wp[i],xp[i]) }           \
@@ -342,6 +353,7 @@ static B modint_AS(B w,   B xv) { return modint_AA(w, C2(shape, C1(fne, incG(w))
     #undef AR_I_AA
     
     #define AR_I_AS(CHR, NAME, EXPR, DO_AS, EXTRA) NOINLINE B NAME##_AS(B t, B w, B x) { \
+      const bool intReuse = NAME##_intReuse;               \
       B r; u8 we=TI(w,elType); EXTRA                       \
       if (isF64(x)) { usz ia=IA(w); DO_AS(NAME,EXPR) }     \
       ARITH_SLOW(CHR); return arith_recd(NAME##_c2, w, x); \
@@ -349,6 +361,7 @@ static B modint_AS(B w,   B xv) { return modint_AA(w, C2(shape, C1(fne, incG(w))
     }
     
     #define AR_I_SA(CHR, NAME, EXPR, DO_SA, EXTRA) NOINLINE B NAME##_SA(B t, B w, B x) { \
+      const bool intReuse = NAME##_intReuse;               \
       B r; u8 xe=TI(x,elType); EXTRA                       \
       if (isF64(w)) { usz ia=IA(x); DO_SA(NAME,EXPR) }     \
       ARITH_SLOW(CHR); return arith_recd(NAME##_c2, w, x); \
@@ -388,6 +401,13 @@ static B modint_AS(B w,   B xv) { return modint_AA(w, C2(shape, C1(fne, incG(w))
       }
     })
     #undef AR_I_AS
+    #undef add_intReuse
+    #undef sub_intReuse
+    #undef mul_intReuse
+    #undef and_intReuse
+    #undef or_intReuse
+    #undef floor_intReuse
+    #undef ceil_intReuse
   #endif // !SINGELI
   
   #define add_AS(T, W, X) add_SA(T, X, W)
@@ -475,9 +495,35 @@ static f64 bqn_atan2  (f64 x, f64 w) { return atan2(x+0, w+0); }
 static f64 bqn_atan2ix(f64 x, f64 w) { return w * tan(x); }
 static f64 bqn_atan2iw(f64 x, f64 w) { return w / (tan(x)+0); }
 
+static NOINLINE B math_recd(f64 (*fn)(f64, f64), FC2 rec, B w, B x) { // consumes; at least one of w and x is an array
+  B r; f64* rp; usz ia;
+  if (isArr(w) && isArr(x)) {
+    if (RNK(w)!=RNK(x) || !eqShPart(SH(w), SH(x), RNK(w)) || !elNum(TI(w,elType)) || !elNum(TI(x,elType))) goto rec;
+    w = toF64Any(w); f64* wp = f64any_ptr(w);
+    x = toF64Any(x); f64* xp = f64any_ptr(x);
+    ia = IA(x); rp = m_tyarrlbcR(&r, 6, x, w, t_f64arr);
+    for (usz i = 0; i < ia; i++) rp[i] = fn(xp[i], wp[i]);
+    decG(w); decG(x);
+  } else if (isArr(x)) {
+    if (!isF64(w) || !elNum(TI(x,elType))) goto rec;
+    x = toF64Any(x); f64* xp = f64any_ptr(x); f64 wv = w.f;
+    ia = IA(x); rp = m_tyarrlbcR(&r, 6, x, x, t_f64arr);
+    for (usz i = 0; i < ia; i++) rp[i] = fn(xp[i], wv);
+    decG(x);
+  } else {
+    if (!isF64(x) || !elNum(TI(w,elType))) goto rec;
+    w = toF64Any(w); f64* wp = f64any_ptr(w); f64 xv = x.f;
+    ia = IA(w); rp = m_tyarrlbcR(&r, 6, w, w, t_f64arr);
+    for (usz i = 0; i < ia; i++) rp[i] = fn(xv, wp[i]);
+    decG(w);
+  }
+  return num_squeeze(r);
+  
+  rec: return arith_recd(rec, w, x);
+}
 #define MATH(n,N,I) B n##_c2(B t, B w, B x) {          \
   if (isNum(w) && isNum(x)) return m_f64(I(x.f, w.f)); \
-  P2(n)                                                \
+  if (isArr(w)|isArr(x)) return math_recd(I, n##_c2, w, x); \
   thrM("•math." N ": Unexpected argument types");      \
 }
 MATH(atan2,"Atan2",bqn_atan2)
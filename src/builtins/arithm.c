@@ -15,7 +15,7 @@ void bit_negatePtr(u64* rp, u64* xp, usz count) {
 }
 B bit_negate(B x) { // consumes
   u64* xp = bitany_ptr(x);
-  u64* rp; B r = m_bitarrc(&rp, x);
+  B r; u64* rp = m_tyarrlbcR(&r, 0, x, x, t_bitarr);
   bit_negatePtr(rp, xp, BIT_N(IA(x)));
   decG(x);
   return r;
@@ -57,14 +57,15 @@ B add_c1(B t, B x) {
 }
 
 #define SIGN_EXPR(T, C) rp[i] = c>0? 1 : c==0? 0 : -1;
-#define SIGN_MAIN(FEXPR) LOOP_BODY(i8* rp; B r=m_i8arrc(&rp,x);, SIGN_EXPR,)
+#define SIGN_MAIN(FEXPR) LOOP_BODY(B r; i8* rp = m_tyarrlbcR(&r, 3, x, x, t_i8arr);, SIGN_EXPR,)
 
+// | may write over an unshared argument even though the integer loops can bail out on overflow, as the retry then just takes the absolute value of some already-absolute values
 #if SINGELI_SIMD
   #define STILE_BODY(FEXPR) { usz ia = IA(x); B r; retry:; \
-    void* rp = m_tyarrlc(&r, elWidth(xe), x, el2t(xe));    \
+    void* rp = m_tyarrlbcR(&r, elwBitLog(xe), x, x, el2t(xe)); \
     u64 got = simd_abs[xe-el_i8](rp, tyany_ptr(x), ia);    \
     if (LIKELY(got==ia)) { decG(x); return r; }            \
-    tyarr_freeF(v(r));                                     \
+    decG(r);                                               \
     xe++;if (xe==el_i16) x=taga(cpyI16Arr(x));             \
     else if (xe==el_i32) x=taga(cpyI32Arr(x));             \
     else                 x=taga(cpyF64Arr(x));             \
@@ -72,12 +73,12 @@ B add_c1(B t, B x) {
   }
 #else
   #define STILE_EXPR(T, C) if(C) goto bad;  ((T*)rp)[i] = c>=0? c : -c;
-  #define STILE_BODY(FEXPR) LOOP_BODY(B r; void* rp = m_tyarrlc(&r, elWidth(xe), x, el2t(xe));, STILE_EXPR, bad: tyarr_freeF(v(r));)
+  #define STILE_BODY(FEXPR) LOOP_BODY(B r; void* rp = m_tyarrlbcR(&r, elwBitLog(xe), x, x, el2t(xe));, STILE_EXPR, bad: decG(r);)
 #endif
 
 #define FLOAT_BODY(FEXPR) { i64 ia = IA(x);                   \
   assert(xe==el_f64); f64* xp = f64any_ptr(x);                \
-  f64* rp; B r = m_f64arrc(&rp, x);                           \
+  B r; f64* rp = m_tyarrlbcR(&r, 6, x, x, t_f64arr);          \
   vfor (usz i = 0; i < ia; i++) { f64 v=xp[i]; rp[i]=FEXPR; } \
   decG(x); return num_squeeze(r);                             \
 }
@@ -100,7 +101,7 @@ GC1i("¬", not,    1-v,             el_bit, bit_negate(x), NOT_BODY)
       if (xe!=el_f64) x=taga(cpyF64Arr(x)); \
       u64 ia = IA(x);                       \
       f64* xp = f64any_ptr(x);              \
-      f64* rp; B r = m_f64arrc(&rp, x);     \
+      B r; f64* rp = m_tyarrlbcR(&r, 6, x, x, t_f64arr); \
       vfor (i64 i = 0; i < ia; i++) {       \
         f64 xv=xp[i]; rp[i] = (F);          \
       }                                     \
@@ -141,13 +142,22 @@ NOINLINE f64 logfact_inv(f64 y) {
 }
 f64 fact_inv(f64 y) { return logfact_inv(log(y)); }
 
-#define P1(N) { if(isArr(x)) { SLOW1("arithm " #N, x); return arith_recm(N##_c1, x); } }
-B   pow_c1(B t, B x) { if (isF64(x)) return m_f64(  exp(x.f)); P1(  pow); thrM("⋆: Argument contained non-number"); }
-B   log_c1(B t, B x) { if (isF64(x)) return m_f64(  log(x.f)); P1(  log); thrM("⋆⁼: Argument contained non-number"); }
+static NOINLINE B arith_recm_f64(f64 (*fn)(f64), FC1 rec, B x) { // consumes; x must be an array
+  if (!elNum(TI(x,elType))) { SLOW1("arithm f64", x); return arith_recm(rec, x); }
+  x = toF64Any(x);
+  usz ia = IA(x);
+  f64* xp = f64any_ptr(x);
+  B r; f64* rp = m_tyarrlbcR(&r, 6, x, x, t_f64arr);
+  for (usz i = 0; i < ia; i++) rp[i] = fn(xp[i]);
+  decG(x); return r;
+}
+#define P1(N,F) { if(isArr(x)) return arith_recm_f64(F, N##_c1, x); }
+B   pow_c1(B t, B x) { if (isF64(x)) return m_f64(  exp(x.f)); P1(  pow, exp); thrM("⋆: Argument contained non-number"); }
+B   log_c1(B t, B x) { if (isF64(x)) return m_f64(  log(x.f)); P1(  log, log); thrM("⋆⁼: Argument contained non-number"); }
 #undef P1
 static NOINLINE B arith_recm_slow(f64 (*fn)(f64), FC1 rec, B x, char* s) {
   if (isF64(x)) return m_f64(fn(x.f));
-  if(isArr(x)) return arith_recm(rec, x);
+  if(isArr(x)) return arith_recm_f64(fn, rec, x);
   thrF("•math.%S: Argument contained non-number", s);
 }
 #define MATH(n,N) B n##_c1(B t, B x) { return arith_recm_slow(n, n##_c1, x, #N); }
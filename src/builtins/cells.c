@@ -125,6 +125,133 @@ B scan_arith(B f, B w, B x, usz* xsh) { // Used by scan.c
   return taga(APD_SH_GET(r, 0));
 }
 
+// Arithmetic scan & insert along an axis, on x viewed as cam cells of m rows of s elements
+// Works a row at a time, so x is read once in order, and the operand's loop vectorizes over the s elements of a row
+// w is bi_N, a number (broadcast to all s elements), or an array of s (shared by all cells) or cam×s elements; consumes w and x, or neither if returning bi_N
+typedef bool (*AxisRowFn)(void* r, void* a, void* b, usz s); // r[i] = a[i] F b[i]; r may equal b; returns whether an integer result overflowed
+#define AXIS_ROW(N, T, EXPR) static bool axis_##N##_##T(void* rv, void* av, void* bv, usz s) { \
+  T* rp=rv; T* ap=av; T* bp=bv;                                 \
+  vfor (usz i=0; i<s; i++) { T a=ap[i], b=bp[i]; rp[i] = EXPR; } \
+  return false;                                                  \
+}
+#define AXIS_ROW_CHK(N, EXPR) static bool axis_##N##_i32(void* rv, void* av, void* bv, usz s) { \
+  i32* rp=rv; i32* ap=av; i32* bp=bv; bool bad=false;           \
+  vfor (usz i=0; i<s; i++) { i64 a=ap[i], b=bp[i]; i64 v = EXPR; rp[i]=(i32)v; bad|= v!=(i32)v; } \
+  return bad;                                                    \
+}
+#define AXIS_ROW_MM(T) AXIS_ROW(floor, T, a>b?b:a) AXIS_ROW(ceil, T, a>b?a:b)
+AXIS_ROW_MM(i8) AXIS_ROW_MM(i16) AXIS_ROW_MM(i32) AXIS_ROW_MM(f64)
+AXIS_ROW(add, f64, a+b) AXIS_ROW(sub, f64, a-b) AXIS_ROW(mul, f64, a*b)
+AXIS_ROW_CHK(add, a+b) AXIS_ROW_CHK(sub, a-b) AXIS_ROW_CHK(mul, a*b)
+AXIS_ROW(and, i8, a&b) AXIS_ROW(or, i8, a|b) AXIS_ROW(ne, i8, a^b) // boolean-valued only
+#undef AXIS_ROW_MM
+#undef AXIS_ROW_CHK
+#undef AXIS_ROW
+
+static AxisRowFn axis_row_fn(u8 rtid, u8 re) {
+  #define AXIS_FN(T) rtid==n_floor? axis_floor_##T : rtid==n_ceil? axis_ceil_##T
+  switch (re) { default: UD;
+    case el_i8:  return AXIS_FN(i8)  : rtid==n_and? axis_and_i8 : rtid==n_or? axis_or_i8 : axis_ne_i8;
+    case el_i16: return AXIS_FN(i16) : NULL;
+    case el_i32: return AXIS_FN(i32) : rtid==n_add? axis_add_i32 : rtid==n_sub? axis_sub_i32 : axis_mul_i32;
+    case el_f64: return AXIS_FN(f64) : rtid==n_add? axis_add_f64 : rtid==n_sub? axis_sub_f64 : axis_mul_f64;
+  }
+  #undef AXIS_FN
+}
+
+// element type the computation is done in, or el_MAX if not supported; booleans are computed as i8
+static u8 axis_arith_type(u8 rtid, u8 we, u8 xe) {
+  if (xe>el_f64 || we>el_f64) return el_MAX;
+  switch (rtid) { default: return el_MAX;
+    case n_floor: case n_ceil: { u8 e = we>xe? we : xe; return e==el_bit? el_i8 : e; }
+    case n_add: case n_sub: case n_mul: return we==el_f64 || xe==el_f64? el_f64 : el_i32;
+    case n_and: case n_or: case n_ne: return (we|xe)==el_bit? el_i8 : el_MAX;
+  }
+}
+static B axis_toType(B x, u8 re) { // consumes
+  switch (re) { default: UD;
+    case el_i8:  return toI8Any(x);
+    case el_i16: return toI16Any(x);
+    case el_i32: return toI32Any(x);
+    case el_f64: return toF64Any(x);
+  }
+}
+
+static B axis_arith(bool scan, u8 rtid, B w, B x, usz cam, usz m, usz s) {
+  assert(isArr(x) && m>0 && IA(x)==cam*m*s);
+  bool hasW = !q_N(w);
+  u8 we = !hasW? el_bit : isArr(w)? TI(w,elType) : selfElType(w);
+  if (hasW && isF64(w) && w.f==0 && w.u!=m_f64(0).u) we = el_f64; // ¯0
+  u8 xe = TI(x,elType);
+  u8 re = axis_arith_type(rtid, we, xe);
+  if (re==el_MAX) return bi_N;
+  assert(!hasW || isF64(w) || IA(w)==s || IA(w)==cam*s);
+  bool bitRes = re==el_i8 && (we|xe)==el_bit;
+
+  retry:;
+  AxisRowFn fn = axis_row_fn(rtid, re);
+  B xc = axis_toType(incG(x), re);
+  B wc = !hasW? bi_N : axis_toType(isArr(w)? incG(w) : taga(reshape_one(s, inc(w))), re);
+  usz rowB = s*elWidth(re);
+  usz wStep = hasW && IA(wc)==cam*s? rowB : 0;
+  B r; u8* rp;
+  if (scan) rp = m_tyarrlbc(&r, elwBitLog(re), x, el2t(re));
+  else      rp = m_tyarrlbv(&r, elwBitLog(re), cam*s, el2t(re));
+  u8* xp = tyany_ptr(xc);
+  u8* wp = hasW? tyany_ptr(wc) : NULL;
+  bool bad = false;
+  for (usz c = 0; c < cam && !bad; c++) {
+    u8* xcp = xp + c*m*rowB;
+    if (scan) { // r[i] = r[i-1] F x[i]
+      u8* rcp = rp + c*m*rowB;
+      if (hasW) bad|= fn(rcp, wp + c*wStep, xcp, s);
+      else memcpy(rcp, xcp, rowB);
+      for (usz i = 1; i < m; i++) bad|= fn(rcp + i*rowB, rcp + (i-1)*rowB, xcp + i*rowB, s);
+    } else { // r = x[0] F x[1] F … F x[m-1] F w, evaluated right to left
+      u8* rcp = rp + c*rowB;
+      u8* xl = xcp + (m-1)*rowB;
+      if (hasW) bad|= fn(rcp, xl, wp + c*wStep, s);
+      else memcpy(rcp, xl, rowB);
+      for (usz i = m-1; i-- > 0; ) bad|= fn(rcp, xcp + i*rowB, rcp, s);
+    }
+  }
+  decG(xc); if (hasW) decG(wc);
+  if (bad) {
+    decG(r);
+    if (rtid==n_mul) return bi_N; // f64 can give ¯0 where integers wouldn't
+    re = el_f64; goto retry; // overflowing + and - give the same results as computing in f64 from the start
+  }
+  decG(x); if (hasW) dec(w);
+  return bitRes? taga(cpyBitArr(r)) : r;
+}
+B scan_cells_arith  (u8 rtid, B w, B x, usz cam, usz m, usz s) { return axis_arith(true,  rtid, w, x, cam, m, s); } // result has the shape of x
+B insert_cells_arith(u8 rtid, B w, B x, usz cam, usz m, usz s) { return axis_arith(false, rtid, w, x, cam, m, s); } // result is a list of cam×s elements
+
+// w F`⎉(-xk) x or w F˝⎉(-xk) x with the same w for all cells (wcr≡¯1 for an atom), or cells of w matching those of x (wcr≡RNK(w)-xk)
+// only handles w cells of the shape of x's cells' major cells; consumes w and x, or neither if returning bi_N
+static B scan_insert_cells_w(Md1D* fd, B w, usz* wcsh, i32 wcr, B x, ur xk) {
+  u8 rtid = fd->m1->flags-1;
+  if ((rtid!=n_scan && rtid!=n_insert) || !isFun(fd->f)) return bi_N;
+  ur xr = RNK(x); usz* xsh = SH(x);
+  if (xr-xk < 1 || TI(x,elType)==el_B) return bi_N;
+  usz cam = shProd(xsh, 0, xk);
+  usz m = xsh[xk];
+  usz s = shProd(xsh, xk+1, xr);
+  if (m==0 || (s==1 && m>64)) return bi_N; // rank 1 special cases are better on long rows
+  if (wcr<0? !isF64(w) || (rtid==n_scan && xr-xk!=1) : wcr!=xr-xk-1 || !eqShPart(wcsh, xsh+xk+1, wcr)) return bi_N;
+  u8 frtid = v(fd->f)->flags-1;
+  if (rtid==n_scan) return scan_cells_arith(frtid, w, x, cam, m, s);
+  incG(x);
+  B r = insert_cells_arith(frtid, w, x, cam, m, s);
+  if (!q_N(r) && xr > 2) {
+    usz* rsh = arr_shAlloc(a(r), xr-1);
+    shcpy(rsh, xsh, xk);
+    shcpy(rsh+xk, xsh+xk+1, xr-1-xk);
+  }
+  decG(x);
+  return r;
+}
+
 
 #if TEST_CELL_FILLS
   i32 fullCellFills = 2*SEMANTIC_CATCH;
@@ -450,6 +577,33 @@ NOINLINE B for_cells_AS(B f, B w, B x, ur wcr, ur wr, u32 chr);
 NOINLINE B for_cells_SA(B f, B w, B x, ur xcr, ur xr, u32 chr); // referenced in fns.c
 NOINLINE B for_cells_AA(B f, B w, B x, ur wcr, ur xcr, u32 chr);
 
+#if PARALLEL
+#include "../utils/each.h"
+typedef struct ParArg { B a; usz csz; ur cr; usz* csh; } ParArg; // cell j of a is its elements j×csz+↕csz, with shape csh of length cr
+typedef struct ParCells { B f; FC1 fc1; FC2 fc2; ParArg w, x; usz wd, xd; } ParCells; // for cell i, the argument's cell is i÷wd or i÷xd; 0 if the argument is used whole
+static ParArg par_arg(B a, ur k) {
+  ur cr = RNK(a)-k;
+  return (ParArg){.a=a, .csz=shProd(SH(a), k, RNK(a)), .cr=cr, .csh=SH(a)+k};
+}
+static B par_slice(ParArg* p, usz d, usz i) {
+  if (d==0) return inc(p->a);
+  Arr* c = TI(p->a,slice)(incG(p->a), i/d*p->csz, p->csz);
+  if (p->cr<=1) return taga(arr_shSetUO(c, p->cr, NULL));
+  ShArr* sh = m_shArr(p->cr);
+  shcpy(sh->a, p->csh, p->cr);
+  return taga(arr_shSetUG(c, p->cr, sh));
+}
+static B par_cell1(void* c, usz i) { ParCells* p = c; return p->fc1(p->f, par_slice(&p->x, 1, i)); }
+static B par_cell2(void* c, usz i) { ParCells* p = c; return p->fc2(p->f, par_slice(&p->w, p->wd, i), par_slice(&p->x, p->xd, i)); }
+static B* par_for_cells(ParCells p, usz cam, bool dy) { // results of all cells if they could be evaluated in parallel, else NULL
+  if (cam<PAR_MIN || !isFun(p.f) || !isPureFn(p.f)) return NULL;
+  if (dy) p.fc2 = c2fn(p.f);
+  else    p.fc1 = c1fn(p.f);
+  return par_cells(cam, dy? par_cell2 : par_cell1, &p);
+}
+#define PAR_APD(R, RS, CAM) ({ for (usz i = 0; i < (CAM); i++) APDD(R, (RS)[i]); par_free(RS, CAM); })
+#endif
+
 static NOINLINE B c1wrap(B f,      B x) { B r = c1(f,    x); return isAtm(r)? m_unit(r) : r; }
 static NOINLINE B c2wrap(B f, B w, B x) { B r = c2(f, w, x); return isAtm(r)? m_unit(r) : r; }
 static u8 reverse_inds_64[128] = {63,62,61,60,59,58,57,56,55,54,53,52,51,50,49,48,47,46,45,44,43,42,41,40,39,38,37,36,35,34,33,32,31,30,29,28,27,26,25,24,23,22,21,20,19,18,17,16,15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0}; // 64 trailing elements for overreading loads
@@ -554,10 +708,11 @@ B for_cells_c1(B f, u32 xr, u32 cr, u32 k, B x, u32 chr) { // F⎉cr x; array x,
           if (TI(x,elType)==el_B) break;
           if (m==1 || frtid==n_ltack) return select_cells(0  , x, cam, k, false);
           if (        frtid==n_rtack) return select_cells(m-1, x, cam, k, false);
-          if (isPervasiveDyExt(fd->f) && 1==shProd(xsh, k+1, xr)) {
-            B r;
-            // special cases always return rank 1
-            // incG(x) preserves the shape to restore afterwards if needed
+          B r;
+          // special cases always return rank 1
+          // incG(x) preserves the shape to restore afterwards if needed
+          usz s = shProd(xsh, k+1, xr);
+          if (isPervasiveDyExt(fd->f) && 1==s) {
             if (TI(x,elType)==el_bit) {
               incG(x); r = fold_rows_bit(fd, x, cam, m);
               if (q_N(r)) decG(x); // will try fold_rows
@@ -567,14 +722,18 @@ B for_cells_c1(B f, u32 xr, u32 cr, u32 k, B x, u32 chr) { // F⎉cr x; array x,
               incG(x); r = fold_rows    (fd, x, cam, m);
             }
             else break;
-            finish_fold:
-            if (xr > 2) {
-              usz* rsh = arr_shAlloc(a(r), xr-1);
-              shcpy(rsh, xsh, k);
-              shcpy(rsh+k, xsh+k+1, xr-1-k);
-            }
-            decG(x); return r;
+          } else {
+            if (s<=1) break;
+            incG(x); r = insert_cells_arith(frtid, bi_N, x, cam, m, s);
+            if (q_N(r)) { decG(x); break; }
           }
+          finish_fold:
+          if (xr > 2) {
+            usz* rsh = arr_shAlloc(a(r), xr-1);
+            shcpy(rsh, xsh, k);
+            shcpy(rsh+k, xsh+k+1, xr-1-k);
+          }
+          decG(x); return r;
         } break;
         case n_scan: {
           if (cr==0) break;
@@ -587,6 +746,10 @@ B for_cells_c1(B f, u32 xr, u32 cr, u32 k, B x, u32 chr) { // F⎉cr x; array x,
               && 1==shProd(xsh, k+1, xr)) {
             B r = scan_rows_bit(frtid, x, m); if (!q_N(r)) return r;
           }
+          usz s = shProd(xsh, k+1, xr);
+          if (s>1 || m<=64 || !(frtid==n_add || frtid==n_floor || frtid==n_ceil)) { // long rows of these are left to the rank 1 special cases
+            B r = scan_cells_arith(frtid, bi_N, x, cam, m, s); if (!q_N(r)) return r;
+          }
           break;
         }
         case n_undo: if (isFun(fd->f)) {
@@ -638,6 +801,10 @@ B for_cells_c1(B f, u32 xr, u32 cr, u32 k, B x, u32 chr) { // F⎉cr x; array x,
   base:;
   
   M_APD_SH_N(r, k, xsh, cam);
+  #if PARALLEL
+    B* rs = par_for_cells((ParCells){.f=f, .x=par_arg(x, k)}, cam, false);
+    if (rs!=NULL) { PAR_APD(r, rs, cam); decG(x); return taga(APD_SH_GET(r, chr)); }
+  #endif
   S_KSLICES(x, xsh, k, cam, 1); FC1 fc1 = c1fn(f);
   for (usz i=0,xp=0; i<cam; i++) APDD(r, fc1(f, SLICEI(x)));
   decG(x);
@@ -728,6 +895,12 @@ NOINLINE B for_cells_AS(B f, B w, B x, ur wcr, ur wr, u32 chr) { // F⟜x⎉wcr
     return const_cells(w, wk, wsh, inc(f), chr);
   }
   generic:;
+  #if PARALLEL
+  {
+    B* rs = par_for_cells((ParCells){.f=f, .w=par_arg(w, wk), .wd=1, .x={.a=x}, .xd=0}, cam, true);
+    if (rs!=NULL) { M_APD_SH_N(r, wk, wsh, cam); PAR_APD(r, rs, cam); decG(w); dec(x); return taga(APD_SH_GET(r, chr)); }
+  }
+  #endif
   S_KSLICES(w, wsh, wk, cam, 1) incBy(x, cam-1);
   M_APD_SH_N(r, wk, wsh, cam); FC2 fc2 = c2fn(f);
   for (usz i=0,wp=0; i<cam; i++) APDD(r, fc2(f, SLICEI(w), x));
@@ -739,6 +912,10 @@ NOINLINE B for_cells_SA(B f, B w, B x, ur xcr, ur xr, u32 chr) { // w⊸F⎉xcr
   usz* xsh=SH(x); usz cam=shProd(xsh,0,xk);
   if (cam==0) return rank2_empty(f, w, 0, x, xk, chr);
   if (isFun(f)) {
+    if (TY(f)==t_md1D) {
+      B r = scan_insert_cells_w(c(Md1D,f), w, isArr(w)? SH(w) : NULL, isArr(w)? RNK(w) : -1, x, xk);
+      if (!q_N(r)) return r;
+    }
     u8 rtid = v(f)->flags-1;
     switch(rtid) {
       case n_rtack: dec(w); return x;
@@ -831,6 +1008,12 @@ NOINLINE B for_cells_SA(B f, B w, B x, ur xcr, ur xr, u32 chr) { // w⊸F⎉xcr
     dec(w);
     return const_cells(x, xk, xsh, inc(f), chr);
   }
+  #if PARALLEL
+  {
+    B* rs = par_for_cells((ParCells){.f=f, .w={.a=w}, .wd=0, .x=par_arg(x, xk), .xd=1}, cam, true);
+    if (rs!=NULL) { M_APD_SH_N(r, xk, xsh, cam); PAR_APD(r, rs, cam); dec(w); decG(x); return taga(APD_SH_GET(r, chr)); }
+  }
+  #endif
   S_KSLICES(x, xsh, xk, cam, 1) incBy(w, cam-1);
   M_APD_SH_N(r, xk, xsh, cam); FC2 fc2 = c2fn(f);
   for (usz i=0,xp=0; i<cam; i++) APDD(r, fc2(f, w, SLICEI(x)));
@@ -872,6 +1055,10 @@ NOINLINE B for_cells_AA(B f, B w, B x, ur wcr, ur xcr, u32 chr) { // w F⎉wcr
       if (rtid==n_couple && wr==xr && eqShPart(wsh+wk, xsh+wk, wcr)) {
         return interleave_cells(w, x, wk);
       }
+      if (TY(f)==t_md1D) {
+        B r = scan_insert_cells_w(c(Md1D,f), w, wsh+wk, wcr, x, xk);
+        if (!q_N(r)) return r;
+      }
     }
     if (isPervasiveDy(f)) {
       if (TI(w,elType)==el_B || TI(x,elType)==el_B) goto generic;
@@ -886,6 +1073,10 @@ NOINLINE B for_cells_AA(B f, B w, B x, ur wcr, ur xcr, u32 chr) { // w F⎉wcr
   generic:;
   
   M_APD_SH_N(r, zk, zsh, cam);
+  #if PARALLEL
+    B* rs = par_for_cells((ParCells){.f=f, .w=par_arg(w, wk), .wd=xkM? ext : 1, .x=par_arg(x, xk), .xd=xkM? 1 : ext}, cam, true);
+    if (rs!=NULL) { PAR_APD(r, rs, cam); decG(w); decG(x); return taga(APD_SH_GET(r, chr)); }
+  #endif
   S_KSLICES(w, wsh, wk, xkM? cam0 : cam, 1) usz wp=0;
   S_KSLICES(x, xsh, xk, xkM? cam : cam0, 1) usz xp=0;
   FC2 fc2 = c2fn(f);
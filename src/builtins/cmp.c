@@ -1,6 +1,7 @@
 #include "../core.h"
 #include "../utils/each.h"
 #include "../utils/calls.h"
+#include "../builtins.h"
 
 static NOINLINE void fillBits(u64* dst, u64 sz, bool v) {
   memset((u8*)dst, v?0xff:0, BIT_N(sz)*8);
@@ -132,7 +133,7 @@ CMP_REC(ne, ne, swapped=0;)
 
 
 B leading_axis_arith(FC2 fc2, B w, B x, usz* wsh, usz* xsh, ur mr);
-#define AL(X) u64* rp; B r = m_bitarrc(&rp, X); usz ria=IA(r)
+#define AL(X,Y) B r; u64* rp = m_tyarrlbcR(&r, 0, X, Y, t_bitarr); usz ria=IA(r) // only boolean arguments can be reused
 #define CMP_AA_D(CN, CR, NAME, PRE) NOINLINE B NAME##_AA(i32 swapped, B w, B x) { PRE \
   u8 xe = TI(x,elType); if (xe==el_B) goto base; \
   u8 we = TI(w,elType); if (we==el_B) goto base; \
@@ -150,7 +151,7 @@ B leading_axis_arith(FC2 fc2, B w, B x, usz* wsh, usz* xsh, ur mr);
     if (we==el_MAX) goto base;           \
     w=tw; x=tx;                          \
   }                                      \
-  AL(x);                                 \
+  AL(x,w);                               \
   if (ria) cmp_fns_##NAME##AA[we](rp, tyany_ptr(w), tyany_ptr(x), ria); \
   decG(w);decG(x); return r;            \
   base: return NAME##_rec(swapped,w,x); \
@@ -167,9 +168,34 @@ CMP_AA_D("≠", "?", ne, swapped=0;)
 
 
 
+static NOINLINE B cmp_sortedSA(u8 rn, B w, B x) { // x rn w for an ordered comparison rn, a sorted integer list x, and a number w; consumes x
+  // the result is a single run of equal bits followed by its negation, so only the boundary has to be found, by binary search
+  usz n = IA(x); u8 xe = TI(x,elType); void* xp = tyany_ptr(x);
+  bool asc = FL_HAS(x, fl_asc);
+  bool lead = asc? rn==n_lt || rn==n_le : rn==n_gt || rn==n_ge; // result for the elements before the boundary
+  bool eqLead = lead == (rn==n_le || rn==n_ge); // whether elements equal to w are before it
+  f64 wf = o2fG(w);
+  usz lo = 0, hi = n;
+  while (lo < hi) {
+    usz m = lo + (hi-lo)/2;
+    f64 v = xe==el_i8? ((i8*)xp)[m] : xe==el_i16? ((i16*)xp)[m] : ((i32*)xp)[m];
+    if (v==wf? eqLead : (v<wf)==asc) lo = m+1; else hi = m;
+  }
+  u64* rp; B r = m_bitarrc(&rp, x);
+  usz cw = lo>>6, rw = BIT_N(n);
+  fillBits(rp, cw*64, lead);
+  if (cw < rw) {
+    u64 a = lead? ~0ULL : 0, m = (1ULL<<(lo&63))-1;
+    rp[cw] = (a&m) | (~a&~m);
+    fillBits(rp+cw+1, (rw-cw-1)*64, !lead);
+  }
+  decG(x); return r;
+}
+
 #define CMP_SA_D(NAME, RNAME, PRE) B NAME##_SA(i32 swapped, B w, B x) { PRE \
   u8 xe = TI(x, elType); if (xe==el_B) goto bad; \
-  AL(x);                                 \
+  if (n_##RNAME!=n_eq && n_##RNAME!=n_ne && xe>=el_i8 && xe<=el_i32 && isF64(w) && RNK(x)==1 && FL_HAS(x, fl_asc|fl_dsc)) return cmp_sortedSA(n_##RNAME, w, x); \
+  AL(x,x);                               \
   if (ria) cmp_fns_##RNAME##AS[xe](rp, tyany_ptr(x), w.u, ria); \
   else dec(w);                           \
   decG(x); return r;                     \
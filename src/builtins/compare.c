@@ -45,6 +45,18 @@ NOINLINE i32 compareF(B w, B x) {
   }
   
   assert(rm<=wia && rm<=xia);
+  u8 we = TI(w,elType);
+  if (we==TI(x,elType) && elChr(we)) { // same-width characters compare by code point, as sort.c's string sorting does
+    void* wp = tyany_ptr(w); void* xp = tyany_ptr(x);
+    if (we==el_c8) {
+      int c = memcmp(wp, xp, rm);
+      return c!=0? (c<0? -1 : 1) : rc;
+    }
+    #define CMP(T) for (u64 i = 0; i < rm; i++) { T wc = ((T*)wp)[i], xc = ((T*)xp)[i]; if (wc!=xc) return wc<xc? -1 : 1; }
+    if (we==el_c16) CMP(u16) else CMP(u32)
+    #undef CMP
+    return rc;
+  }
   SGetU(w) SGetU(x)
   for (u64 i = 0; i < rm; i++) {
     i32 c = compare(GetU(w,i), GetU(x,i));
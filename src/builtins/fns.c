@@ -100,9 +100,9 @@ B ud_c1(B t, B x) {
     if (RARE(xu<=2)) return taga(ptr_inc(bitUD[xu]));
     i8* rp; B r = m_i8arrv(&rp, xu);
     NOUNROLL for (usz i = 0; i < xu; i++) rp[i] = i;
-    return r;
+    return FL_SET(r, fl_asc|fl_squoze);
   }
-  return intRange(0, xu);
+  return FL_SET(intRange(0, xu), fl_asc|fl_squoze);
 }
 
 B slash_c2(B t, B w, B x);
@@ -7,12 +7,13 @@
 // +⌈⌊× on numbers
 //   Integer +: sum blocks associatively as long as sum can't exceed +-2⋆53
 //   COULD implement fast numeric -´
+//   ⌈⌊ on integers flagged sorted (e.g. ↕n): first or last element
 // ∨ on boolean-valued integers, stopping at 1
 
 // •math.Sum: +´ with faster and more precise SIMD code for i32, f64
 
 // Insert with rank (˝˘ or ˝⎉k), or fold on flat array
-// SHOULD optimize dyadic insert with rank
+// Dyadic, 𝕨 a number or matching result cells: row-at-a-time kernel, as below
 // Length 1, ⊣⊢: implemented as ⊏˘
 // ∾˝ with rank: reshape argument
 // Arithmetic on empty: reshape identity
@@ -37,7 +38,10 @@
 //   COULD implement boolean -˝˘ with xor, +˝˘, offset
 // Arithmetic on rank 2, short rows: transpose then insert, blocked
 //   SHOULD extend transpose-insert code to any frame and cell rank
-//   SHOULD have dedicated +⌊⌈ insert with rank
+// Arithmetic +-×⌊⌈ and boolean ∧∨≠, cell size >1 (or short rows): row-at-a-time kernel
+//   Accumulates right to left a row at a time, vectorizing over the cell
+//   Integers overflow-checked, + and - retry in f64, × falls back to generic
+// High-rank insert without rank uses the same kernel
 
 #include "../core.h"
 #include "../builtins.h"
@@ -233,6 +237,7 @@ B fold_c1(Md1D* d, B x) { B f = d->f;
                     : sum_fns[sel](xv, ia, 0);
       decG(x); return m_f64(r);
     }
+    if ((rtid==n_floor | rtid==n_ceil) && xe!=el_f64 && FL_HAS(x, fl_asc|fl_dsc)) return TO_GET(x, (rtid==n_ceil)==FL_HAS(x, fl_asc)? ia-1 : 0); // sorted integers: an endpoint
     if (rtid==n_floor) { f64 r=min_fns[xe-el_i8](tyany_ptr(x), ia); decG(x); return m_f64(r); } // ⌊
     if (rtid==n_ceil ) { f64 r=max_fns[xe-el_i8](tyany_ptr(x), ia); decG(x); return m_f64(r); } // ⌈
     if (rtid==n_mul | rtid==n_and) { // ×/∧
@@ -382,6 +387,19 @@ static B m1c1(B t, B f, B x) { // consumes x
   return r;
 }
 extern B insert_base(B f, B x, bool has_w, B w); // from cells.c
+extern B insert_cells_arith(u8 rtid, B w, B x, usz cam, usz m, usz s); // from cells.c
+static B insert_highrank_arith(B f, B w, B x) { // 𝕨 F˝ 𝕩 (w≡bi_N if monadic) for non-empty x with rank>1; returns bi_N if unhandled
+  usz len = *SH(x);
+  incG(x);
+  B r = insert_cells_arith(v(f)->flags-1, w, x, 1, len, IA(x)/len);
+  ur rr = RNK(x)-1;
+  if (!q_N(r) && rr>1) {
+    usz* rsh = arr_shAlloc(a(r), rr);
+    shcpy(rsh, SH(x)+1, rr);
+  }
+  decG(x);
+  return r;
+}
 
 B insert_c1(Md1D* d, B x) { B f = d->f;
   ur xr;
@@ -439,6 +457,10 @@ B insert_c1(Md1D* d, B x) { B f = d->f;
       else arr_shVec(r);
       return taga(r);
     }
+    if (xr>1) {
+      B r = insert_highrank_arith(f, bi_N, x);
+      if (!q_N(r)) return r;
+    }
   }
   return insert_base(f, x, 0, m_f64(0));
 }
@@ -474,6 +496,10 @@ B insert_c2(Md1D* d, B w, B x) { B f = d->f;
     u8 rtid = v(f)->flags-1;
     if (rtid==n_ltack) { dec(w); return C1(select, x); }
     if (rtid==n_rtack) { decG(x); return w; }
+    if (xr>1 && (isArr(w)? ptr_eqShape(SH(w), RNK(w), SH(x)+1, xr-1) : isF64(w))) {
+      B r = insert_highrank_arith(f, w, x);
+      if (!q_N(r)) return r;
+    }
   }
   return insert_base(f, x, 1, w);
 }
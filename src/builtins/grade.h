@@ -13,6 +13,7 @@
 // Other 1-, 2-, 4-byte cases: radix sort
 //   Singeli +` used if available, speeding up shorter cases
 //   SHOULD skip steps where all bytes are equal
+// Lists of strings: multikey quicksort, stable for grade (see sort.c)
 // General case: Timsort
 // SHOULD check for sorted flag and scan for sortedness in all cases
 // SHOULD use an adaptive quicksort for 4- and 8-byte arguments
@@ -38,6 +39,7 @@
 //     1-byte, no duplicates or few uniques: vector bit-table lookup
 //   General: interleaved branchless binary search
 //   COULD start interleaved search with a vector binary round
+// Lists of strings: branching binary search with a string comparison
 // General case: branching binary search
 // COULD trim 𝕨 based on range of 𝕩
 // COULD optimize small-range 𝕨 with small-type methods
@@ -189,6 +191,18 @@ B SORT_C1(B t, B x) {
   if (isAtm(x) || RNK(x)==0) thrM(GRADE_UD("∧","∨")": Argument cannot have rank 0");
   usz n = *SH(x);
   if (n <= 1) return x;
+  if (RNK(x)==2 && elChr(TI(x,elType)) && n<I32_MAX) { // rows of a character matrix
+    TALLOC(i32, g, n);
+    str_gradeRows(x, n, g, GRADE_UD(0,1));
+    u8 w = elWidth(TI(x,elType));
+    u64 cb = arr_csz(x)*(u64)w;
+    u8* xp = tyany_ptr(x);
+    B r; u8* rp = m_tyarrc(&r, w, x, el2t(TI(x,elType)));
+    for (usz i = 0; i < n; i++) memcpy(rp + i*cb, xp + g[i]*cb, cb);
+    TFREE(g);
+    decG(x);
+    return r;
+  }
   if (RNK(x)!=1) return IA(x)<=1? x : bqn_merge(SORT_C1(t, toCells(x)), 0);
   u8 xe = TI(x,elType);
   B r;
@@ -237,9 +251,23 @@ B SORT_C1(B t, B x) {
     }
   } else {
     B xf = getFillR(x);
-    HArr* r0 = (HArr*)cpyHArr(incG(x));
-    CAT(GRADE_UD(bA,bD),tim_sort)(r0->a, n);
-    r = withFill(taga(r0), xf);
+    TALLOC(i32, g, n);
+    if (xe==el_B && n<I32_MAX && str_grade(x, n, g, GRADE_UD(0,1))) {
+      if (isStrList(x)) {
+        r = strlist_select(c(StrList,x), g, n);
+        dec(xf);
+      } else {
+        SGetU(x)
+        M_HARR(r0, n);
+        for (usz i = 0; i < n; i++) HARR_ADD(r0, i, inc(GetU(x, g[i])));
+        r = withFill(HARR_FV(r0), xf);
+      }
+    } else {
+      HArr* r0 = (HArr*)cpyHArr(incG(x));
+      CAT(GRADE_UD(bA,bD),tim_sort)(r0->a, n);
+      r = withFill(taga(r0), xf);
+    }
+    TFREE(g);
   }
   decG(x);
   return FL_SET(r, CAT(fl,GRADE_UD(asc,dsc)));
@@ -261,7 +289,16 @@ extern B grade_bool(B x, usz ia, bool up); // slash.c
 #define GRADE_CHR GRADE_UD("⍋","⍒")
 B GRADE_CAT(c1)(B t, B x) {
   if (isAtm(x) || RNK(x)==0) thrM(GRADE_CHR": Argument cannot be a unit");
-  if (RNK(x)>1) x = toCells(x);
+  if (RNK(x)>1) {
+    usz n = SH(x)[0];
+    if (RNK(x)==2 && elChr(TI(x,elType)) && n>2 && n<=I32_MAX) { // rows of a character matrix
+      i32* gp; B g = m_i32arrv(&gp, n);
+      str_gradeRows(x, n, gp, GRADE_UD(0,1));
+      decG(x);
+      return n<=(I8_MAX+1)? taga(cpyI8Arr(g)) : n<=(I16_MAX+1)? taga(cpyI16Arr(g)) : g;
+    }
+    x = toCells(x);
+  }
   usz ia = IA(x);
   B r;
   if (ia<=2) {
@@ -329,6 +366,7 @@ B GRADE_CAT(c1)(B t, B x) {
     goto decG_sq;
   }
   if (elChr(xe)) { x = taga(cpyC32Arr(x)); goto el32; }
+  if (xe==el_B && str_grade(x, ia, rp, GRADE_UD(0,1))) goto decG_sq;
   
   SLOW1(GRADE_CHR"𝕩", x);
   generic_grade(x, ia, r, rp, CAT(GRADE_CAT(BP),tim_sort));
@@ -536,6 +574,24 @@ B GRADE_CAT(c2)(B t, B w, B x) {
     }
     #endif
   } else {
+    if (we==el_B && xe==el_B) { // lists of strings
+      TALLOC(StrV, wv, wia+(u64)xia); StrV* xv = wv+wia;
+      bool ok = str_views(w, wia, wv) && str_views(x, xia, xv);
+      if (ok) {
+        i32* rp; r = m_i32arrc(&rp, x);
+        for (usz i = 0; i < xia; i++) {
+          usz s = 0, e = wia+1;
+          while (e-s > 1) {
+            usz m = (s+e) / 2;
+            if (str_cmp(xv[i], wv[m-1], 0) LT 0) e = m;
+            else s = m;
+          }
+          rp[i] = s;
+        }
+      }
+      TFREE(wv);
+      if (ok) goto done;
+    }
     #if !SINGELI
     gen:;
     #endif
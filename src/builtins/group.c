@@ -11,17 +11,23 @@
 // If +´𝕨<¯1 is large, filter out ¯1s.
 //   COULD recompute statistics, may have enabled chunked or sorted code
 // If ∧´1↓»⊸<𝕨, that is, ∧⊸≡𝕨, each result array is a slice of 𝕩
-//   COULD use slice types; seems dangerous--when will they be freed?
+//   For a character list 𝕩 with many groups, gives a strlist over 𝕩 (offsets only, no per-group arrays)
+//   Otherwise COULD use slice types; seems dangerous--when will they be freed?
 // Remaining cases copy cells from 𝕩 individually
 //   Converts 𝕨 to i32, COULD handle smaller types
 //   CPU-sized cells handled quickly, 1-bit with bitp_get/set
 //   SHOULD use memcpy and bit_cpy for other sizes
 //   TRIED separating neg>0 and neg==0 loops, no effect
 
+// Under Group: 𝔽⌾(𝕨⊸⊔)𝕩 native for rank-1 integer 𝕨 and list 𝕩
+//   Calls 𝔽 on the groups, then scatters each result back to where its group came from
+//   Writes over 𝕩 in place if it is reusable and has the result type
+
 #include "../core.h"
 #include "../utils/talloc.h"
 #include "../utils/calls.h"
 #include "../utils/mut.h"
+#include "../builtins.h"
 
 extern B ud_c1(B, B);
 extern B ne_c2(B, B, B);
@@ -80,6 +86,19 @@ static B group_simple(B w, B x, ur xr, usz wia, usz xn, usz* xsh, u8 we) {
   if (bad) thrM("⊔: 𝕨 can't contain elements less than ¯1");
   if (ria > (i64)(USZ_MAX)) thrOOM();
   
+  if (sort && we!=el_bit && xr==1 && elChr(TI(x,elType)) && ria>=STRLIST_MIN) {
+    w = toI32Any(w);
+    i32* wp = tyany_ptr(w);
+    StrList* r = m_strlistp(x, true, ria);
+    usz* off = r->off;
+    for (usz i = 0; i <= ria; i++) off[i] = 0;
+    for (usz i = neg; i < xn; i++) off[wp[i]+1]++;
+    off[0] = neg;
+    for (usz i = 0; i < ria; i++) off[i+1]+= off[i];
+    decG(w);
+    return taga(r);
+  }
+  
   Arr* r = m_fillarr0p(ria);
   B* rp = fillarrv_ptr(r);
   
@@ -286,3 +305,82 @@ B group_c1(B t, B x) {
   }
   return c1rt(group, x);
 }
+
+B group_ucw(B t, B o, B w, B x) {
+  if (isAtm(x) || isAtm(w) || RNK(w)!=1 || RNK(x)!=1) { def: return def_fn_ucw(t, o, w, x); }
+  if (!elInt(TI(w,elType))) {
+    w = num_squeezeChk(w);
+    if (!elInt(TI(w,elType))) goto def;
+  }
+  B grp = C2(group, incG(w), incG(x));
+  usz gn = IA(grp);
+  B rep = c1(o, grp);
+  if (isAtm(rep) || RNK(rep)!=1 || IA(rep)!=gn) thrF("𝔽⌾(a⊸⊔)𝕩: 𝔽 must return an array with the same shape as its input (expected ⟨%s⟩, got %H)", gn, rep);
+  
+  usz xia = IA(x);
+  w = toI32Any(w);
+  i32* wp = i32any_ptr(w);
+  TALLOC(usz, pos, gn);
+  for (usz g = 0; g < gn; g++) pos[g] = 0;
+  for (usz i = 0; i < xia; i++) if (wp[i]>=0) pos[wp[i]]++;
+  u8 re = TI(x,elType);
+  SGetU(rep)
+  for (usz g = 0; g < gn; g++) {
+    B c = GetU(rep, g);
+    if (isAtm(c) || RNK(c)!=1 || IA(c)!=pos[g]) { usz l = pos[g]; TFREE(pos); thrF("𝔽⌾(a⊸⊔)𝕩: 𝔽 must not change the shapes of groups (expected ⟨%s⟩ for group %s, got %H)", l, g, c); }
+    re = el_or(re, TI(c,elType));
+    pos[g] = 0;
+  }
+  
+  B r;
+  if (re==el_B || re==el_bit) { // generic
+    MAKE_MUT_INIT(m, xia, re? re : el_i8); MUTG_INIT(m);
+    SGet(x)
+    for (usz i = 0; i < xia; i++) {
+      i32 g = wp[i];
+      mut_setG(m, i, g<0? Get(x, i) : IGet(GetU(rep, g), pos[g]++));
+    }
+    r = mut_fcd(m, x);
+    if (re==el_bit) r = taga(cpyBitArr(r));
+  } else { // typed: convert groups to the result type, then write them over x or a copy of it
+    TALLOC(B, gs, gn);
+    TALLOC(void*, gp, gn);
+    for (usz g = 0; g < gn; g++) {
+      B c = inc(GetU(rep, g));
+      switch (re) { default: UD;
+        case el_i8:  c = toI8Any(c);  break; case el_c8:  c = toC8Any(c);  break;
+        case el_i16: c = toI16Any(c); break; case el_c16: c = toC16Any(c); break;
+        case el_i32: c = toI32Any(c); break; case el_c32: c = toC32Any(c); break;
+        case el_f64: c = toF64Any(c); break;
+      }
+      gs[g] = c; gp[g] = tyany_ptr(c);
+    }
+    void* rp;
+    if (reusable(x) && TY(x)==el2t(re)) {
+      r = REUSE(x);
+      rp = tyarr_ptr(r);
+    } else {
+      MAKE_MUT(m, xia); mut_init_copy(m, x, re);
+      rp = m->a;
+      r = taga(mut_fp(m));
+    }
+    #define IMPL(T) for (usz i = 0; i < xia; i++) { i32 g = wp[i]; if (g>=0) ((T*)rp)[i] = ((T*)gp[g])[pos[g]++]; }
+    switch (elwBitLog(re)) { default: UD;
+      case 3: IMPL(u8); break;
+      case 4: IMPL(u16); break;
+      case 5: IMPL(u32); break;
+      case 6: IMPL(u64); break;
+    }
+    #undef IMPL
+    for (usz g = 0; g < gn; g++) decG(gs[g]);
+    TFREE(gp);
+    TFREE(gs);
+  }
+  TFREE(pos);
+  decG(w); decG(rep);
+  return r;
+}
+
+void group_init(void) {
+  c(BFn,bi_group)->ucw = group_ucw;
+}
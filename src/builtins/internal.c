@@ -183,6 +183,7 @@ B variation_c2(B t, B w, B x) {
     else if (u8_get(&wp, wpE, "c16")) res = taga(cpyC16Arr(incG(x)));
     else if (u8_get(&wp, wpE, "c32")) res = taga(cpyC32Arr(incG(x)));
     else if (u8_get(&wp, wpE, "f64")) res = taga(cpyF64Arr(incG(x)));
+    else if (u8_get(&wp, wpE, "sl" )) res = taga(cpyStrList(incG(x)));
     else if (u8_get(&wp, wpE, "h"  )) res = taga(cpyHArr  (incG(x)));
     else if (u8_get(&wp, wpE, "f")) {
       Arr* r = m_fillarrp(xia);
@@ -243,6 +244,7 @@ static B unshare(B x) {
     case t_c16arr: case t_c16slice: return unshareShape((Arr*)cpyC16Arr(incG(x)));
     case t_c32arr: case t_c32slice: return unshareShape((Arr*)cpyC32Arr(incG(x)));
     case t_f64arr: case t_f64slice: return unshareShape((Arr*)cpyF64Arr(incG(x)));
+    case t_strlist:                 return unshareShape(cpyStrList(incG(x)));
     case t_harr: case t_hslice: {
       B* xp = TY(x)==t_harr? harr_ptr(x) : hslice_ptr(x);
       M_HARR(r, xia)
@@ -274,7 +276,7 @@ B eequal_c2(B t, B w, B x) {
 #endif
 #if NATIVE_COMPILER
   extern B native_comp;
-  void switchComp(void);
+  B native_exec(B str, B state);
 #endif
 #if TEST_CELL_FILLS
   extern i32 fullCellFills;
@@ -301,10 +303,7 @@ B internalTemp_c1(B t, B x) {
     return r;
   #endif
   #if NATIVE_COMPILER
-    switchComp();
-    B r = bqn_exec(x, bi_N);
-    switchComp();
-    return r;
+    return native_exec(x, bi_N);
   #endif
   #ifdef TEST_BITCPY
     SGetU(x)
@@ -362,6 +361,18 @@ B heapStats_c1(B t, B x) {
   return m_f64(1);
 }
 
+u32 allocSites_start(u32 period);
+B allocSites_report(void);
+B allocSites_c1(B t, B x) {
+  #if ALLOC_SITES
+    if (isC32(x)) return allocSites_report();
+    if (!q_i32(x) || o2iG(x)<0) thrM("•internal.AllocSites: 𝕩 must be @ or a non-negative integer");
+    return m_f64(allocSites_start(o2iG(x)));
+  #else
+    thrM("•internal.AllocSites: CBQN must be built with ALLOC_SITES=1");
+  #endif
+}
+
 B iObjFlags_c1(B t, B x) {
   u8 r = v(x)->flags;
   decG(x);
@@ -404,8 +415,8 @@ B getInternalNS(void) {
     #undef F
     
     #define F(X) incG(bi_##X),
-    Body* d =    m_nnsDesc("type","eltype","refc","squeeze","ispure","info", "keep", "purekeep","listvariations","variation","clearrefs", "hasfill","unshare","deepsqueeze","heapdump","eequal",        "gc",        "temp","heapstats", "objflags");
-    internalNS = m_nns(d,F(itype)F(elType)F(refc)F(squeeze)F(isPure)F(info)F(iKeep)F(iPureKeep)F(listVariations)F(variation)F(clearRefs)F(iHasFill)F(unshare)F(deepSqueeze)F(heapDump)F(eequal)F(internalGC)F(internalTemp)F(heapStats)F(iObjFlags));
+    Body* d =    m_nnsDesc("type","eltype","refc","squeeze","ispure","info", "keep", "purekeep","listvariations","variation","clearrefs", "hasfill","unshare","deepsqueeze","heapdump","eequal",        "gc",        "temp","heapstats", "allocsites", "objflags");
+    internalNS = m_nns(d,F(itype)F(elType)F(refc)F(squeeze)F(isPure)F(info)F(iKeep)F(iPureKeep)F(listVariations)F(variation)F(clearRefs)F(iHasFill)F(unshare)F(deepSqueeze)F(heapDump)F(eequal)F(internalGC)F(internalTemp)F(heapStats)F(allocSites)F(iObjFlags));
     #undef F
     gc_add(internalNS);
   }
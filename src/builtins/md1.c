@@ -2,6 +2,8 @@
 #include "../utils/mut.h"
 #include "../utils/each.h"
 #include "../utils/time.h"
+#include "../utils/perf.h"
+#include "../ns.h"
 #include "../builtins.h"
 
 
@@ -37,6 +39,7 @@ static NOINLINE B homFil2(B f, B r, B wf, B xf) {
 }
 
 B each_c1(Md1D* d, B x) { B f = d->f;
+  if (isStrList(x) && isFun(f) && v(f)->flags-1==n_ne) return strlist_lengths(x);
   B r, xf;
   if (EACH_FILLS) xf = getFillR(x);
   
@@ -47,7 +50,13 @@ B each_c1(Md1D* d, B x) { B f = d->f;
       if (EACH_FILLS) decG(xf);
       return EACH_FILLS || TI(x,arrD1) || IA(x)==0? x : any_squeeze(withFill(x, bi_noFill));
     }
-    r = eachm_fn(f, x, c(Fun,f)->c1);
+    #if PARALLEL
+      r = par_eachm(f, x);
+      if (q_N(r)) r = eachm_fn(f, x, c(Fun,f)->c1);
+      else decG(x);
+    #else
+      r = eachm_fn(f, x, c(Fun,f)->c1);
+    #endif
   } else {
     usz ia = IA(x);
     if (isMd(f) && ia>0) { decR(x); thrM("Calling a modifier"); }
@@ -64,6 +73,10 @@ B tbl_c1(Md1D* d, B x) {
 
 B slash_c2(B t, B w, B x);
 B shape_c2(B t, B w, B x);
+#if PARALLEL
+typedef struct ParTbl { B f; FC2 fc2; B w, x; usz xia; } ParTbl;
+static B tbl_parCell(void* c, usz i) { ParTbl* p = c; return p->fc2(p->f, IGet(p->w, i/p->xia), IGet(p->x, i%p->xia)); }
+#endif
 B tbl_c2(Md1D* d, B w, B x) { B f = d->f;
   if (isAtm(w)) w = m_unit(w);
   if (isAtm(x)) x = m_unit(x);
@@ -110,6 +123,13 @@ B tbl_c2(Md1D* d, B w, B x) { B f = d->f;
     SGetU(w) SGet(x)
     
     M_HARR(r, ria)
+    #if PARALLEL
+      B* rs = ria>=PAR_MIN && isPureFn(f)? par_cells(ria, tbl_parCell, &(ParTbl){.f=f, .fc2=fc2, .w=w, .x=x, .xia=xia}) : NULL;
+      if (rs!=NULL) {
+        for (usz i = 0; i < ria; i++) HARR_ADDA(r, rs[i]);
+        par_free(rs, ria);
+      } else
+    #endif
     for (usz wi = 0; wi < wia; wi++) {
       B cw = incBy(GetU(w,wi), xia);
       for (usz xi = 0; xi < xia; xi++) HARR_ADDA(r, fc2(f, cw, Get(x,xi)));
@@ -135,6 +155,10 @@ B tbl_c2(Md1D* d, B w, B x) { B f = d->f;
 
 static B eachd(B f, B w, B x) {
   if (isAtm(w) & isAtm(x)) return m_hunit(c2(f, w, x));
+  #if PARALLEL
+    B r = par_eachd(f, w, x);
+    if (!q_N(r)) { dec(w); dec(x); return r; }
+  #endif
   return eachd_fn(f, w, x, c2fn(f));
 }
 
@@ -154,7 +178,7 @@ B swap_c2(Md1D* d, B w, B x) { return c2(d->f,     x , w); }
 
 B timed_c2(Md1D* d, B w, B x) { B f = d->f;
   i64 am = o2i64(w);
-  if (am<=0) thrM("•_timed: 𝕨 must be an integer greater than 1");
+  if (am<=0) thrM("•_timed: 𝕨 must be a positive integer");
   incBy(x, am-1);
   FC1 fc1 = c1fn(f);
   u64 sns = nsTime();
@@ -169,6 +193,43 @@ B timed_c1(Md1D* d, B x) { B f = d->f;
   return m_f64((ens-sns)*1e-9);
 }
 
+// •_timedPerf: like •_timed, but gives a namespace of the time and performance counters per iteration; ¯1 for unavailable counters
+STATIC_GLOBAL Body* timedPerf_ns;
+static B timedPerf_res(u64 ns, PerfCounts* s, PerfCounts* e, i64 am) {
+  if (timedPerf_ns==NULL) {
+    char* names[PERF_CNT_N+1] = {"time"};
+    for (i32 i = 0; i < PERF_CNT_N; i++) names[i+1] = perf_names[i];
+    timedPerf_ns = m_nnsDescF(PERF_CNT_N+1, names);
+  }
+  PerfCounts d;
+  perf_diff(&d, s, e, am);
+  B vals[PERF_CNT_N+1] = {m_f64(ns/(1e9*am))};
+  for (i32 i = 0; i < PERF_CNT_N; i++) vals[i+1] = m_f64(d.c[i]);
+  return m_nnsF(timedPerf_ns, PERF_CNT_N+1, vals);
+}
+B timedPerf_c2(Md1D* d, B w, B x) { B f = d->f;
+  i64 am = o2i64(w);
+  if (am<=0) thrM("•_timedPerf: 𝕨 must be a positive integer");
+  incBy(x, am-1);
+  FC1 fc1 = c1fn(f);
+  PerfCounts s, e;
+  perf_read(&s);
+  u64 sns = nsTime();
+  for (i64 i = 0; i < am; i++) dec(fc1(f, x));
+  u64 ens = nsTime();
+  perf_read(&e);
+  return timedPerf_res(ens-sns, &s, &e, am);
+}
+B timedPerf_c1(Md1D* d, B x) { B f = d->f;
+  PerfCounts s, e;
+  perf_read(&s);
+  u64 sns = nsTime();
+  dec(c1(f, x));
+  u64 ens = nsTime();
+  perf_read(&e);
+  return timedPerf_res(ens-sns, &s, &e, 1);
+}
+
 static void print_md1BI(FILE* f, B x) { fprintf(f, "%s", pm1_repr(c(Md1,x)->extra)); }
 static B md1BI_im(Md1D* d,      B x) { return ((BMd1*)d->m1)->im(d,    x); }
 static B md1BI_iw(Md1D* d, B w, B x) { return ((BMd1*)d->m1)->iw(d, w, x); }
@@ -15,11 +15,12 @@
 //   + Overflow-checked scalar or AVX2
 //   Ad-hoc boolean-valued handling for ≠∨
 // SHOULD extend rank 1 special cases to cell bound 1
-// Higher-rank arithmetic, non-tiny cells: apply operand cell-wise
-//   SHOULD have dedicated high-rank scan optimizations
+// Higher-rank arithmetic, +-×⌊⌈ and boolean ∧∨≠: row-at-a-time kernel shared with scan with rank
+//   Integers overflow-checked, + and - retry in f64
+// Other higher-rank arithmetic, non-tiny cells: apply operand cell-wise
 
 // Scan with rank (`˘ or `⎉k)
-// SHOULD optimize dyadic scan with rank
+// Dyadic, 𝕨 a number or matching cells' major cells: row-at-a-time kernel, as below
 // Empty 𝕩, length 1, ⊢: return 𝕩
 // Boolean operand, cell size 1:
 //   ≠∨∧⊣ and synonyms, rows <64: SWAR, AVX2 (SHOULD add SSE, NEON)
@@ -33,7 +34,8 @@
 //     SHOULD have a better intermediate-size (< ~256) SIMD method
 //   + scan in blocks, correct with mask, ⌊`, subtract
 //   = as ≠`⌾¬, - as (2×⊣`)-+`
-// SHOULD optimize non-boolean scan with rank
+// Non-boolean, or cell size >1: row-at-a-time kernel for +-×⌊⌈ and boolean ∧∨≠
+//   Rank 1 special cases used instead for cell size 1 with long rows of +⌊⌈
 
 #include "../core.h"
 #include "../utils/mut.h"
@@ -228,6 +230,7 @@ static B scan_plus(f64 r0, B x, u8 xe, usz ia) {
 }
 
 extern B scan_arith(B f, B w, B x, usz* xsh); // from cells.c
+extern B scan_cells_arith(u8 rtid, B w, B x, usz cam, usz m, usz s); // from cells.c
 B scan_c1(Md1D* d, B x) { B f = d->f;
   if (isAtm(x) || RNK(x)==0) thrM("`: Argument cannot have rank 0");
   ur xr = RNK(x);
@@ -284,6 +287,10 @@ B scan_c1(Md1D* d, B x) { B f = d->f;
     if (rtid==n_or) { x=num_squeezeChk(x); xe=TI(x,elType); if (xe==el_bit) return scan_or(x, ia); }
   }
   base:;
+  if (xr>1 && v(f)->flags) {
+    B r = scan_cells_arith(v(f)->flags-1, bi_N, x, 1, *SH(x), ia / *SH(x));
+    if (!q_N(r)) return r;
+  }
   if (xr>1 && ia >= 6 * (u64)*SH(x) && isPervasiveDy(f)) return scan_arith(f, m_f64(0), x, SH(x));
   SLOW2("𝕎` 𝕩", f, x);
   B xf = getFillR(x);
@@ -360,6 +367,10 @@ B scan_c2(Md1D* d, B w, B x) { B f = d->f;
     }
   }
   base:;
+  if (xr>1 && v(f)->flags) {
+    B r = scan_cells_arith(v(f)->flags-1, w, x, 1, *SH(x), ia / *SH(x));
+    if (!q_N(r)) return r;
+  }
   if (xr>1 && ia >= 6 * (u64)*SH(x) && isPervasiveDy(f)) return scan_arith(f, w, x, SH(x));
   SLOW3("𝕨 F` 𝕩", w, x, f);
   B wf = getFillR(w);
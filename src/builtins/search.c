@@ -36,6 +36,7 @@
 #include "../utils/hash.h"
 #include "../utils/talloc.h"
 #include "../utils/calls.h"
+#include "../builtins.h"
 
 extern NOINLINE void memset16(u16* p, u16 v, usz l) { for (usz i=0; i<l; i++) p[i]=v; }
 extern NOINLINE void memset32(u32* p, u32 v, usz l) { for (usz i=0; i<l; i++) p[i]=v; }
@@ -248,6 +249,10 @@ static NOINLINE usz indexOfOne(B l, B e) {
   } else
 
 B indexOf_c2(B t, B w, B x) {
+  if (isStrList(w) || isStrList(x)) {
+    B r = strlist_search(n_indexOf, w, x);
+    if (!q_N(r)) { decG(w); decG(x); return r; }
+  }
   bool split = 0; (void) split;
   if (RARE(!isArr(w) || RNK(w)!=1)) {
     split = 1;
@@ -361,6 +366,10 @@ B indexOf_c2(B t, B w, B x) {
 
 GLOBAL B enclosed_0, enclosed_1;
 B memberOf_c2(B t, B w, B x) {
+  if (isStrList(w) || isStrList(x)) {
+    B r = strlist_search(n_memberOf, w, x);
+    if (!q_N(r)) { decG(w); decG(x); return r; }
+  }
   bool split = 0; (void) split;
   if (isAtm(x) || RNK(x)!=1) {
     split = 1;
@@ -614,6 +623,7 @@ typedef struct HashMap {
   u64 pop; // count of defined entries
   u64 sh;  // shift to turn hash into index
   u64 sz;  // count of allocated entries, a power of 2
+  u64 atm; // whether every key inserted so far is a number or character; if so, keys are compared by value instead of with equal
   u64 a[]; // lower 32 bits: index into keys/vals; upper 32 bits: upper 32 bits of hash
 } HashMap;
 static u64 hashmap_size(usz sh) { return ((u64)1 << (64-sh)) + 32; }
@@ -624,7 +634,7 @@ usz hashmap_count(B hash) { return c(HashMap, hash)->pop; }
 
 static HashMap* hashmap_alloc(usz pop, usz sh, u64 sz) {
   HashMap* map = mm_alloc(fsizeof(HashMap,a,u64,sz), t_hashmap);
-  map->pop = pop; map->sh = sh; map->sz = sz;
+  map->pop = pop; map->sh = sh; map->sz = sz; map->atm = 1;
   memset64(map->a, empty, sz);
   return map;
 }
@@ -634,6 +644,7 @@ static NOINLINE HashMap* hashmap_resize(HashMap* old_map) {
   if (sh < 32) thrM("•HashMap: hash size maximum exceeded");
   u64 sz = hashmap_size(sh);
   HashMap* map = hashmap_alloc(old_map->pop, sh, sz);
+  map->atm = old_map->atm;
   for (u64 i=0, j=-(u64)1; i<old_map->sz; i++) {
     u64 h = old_map->a[i];
     if (h == empty) continue;
@@ -685,17 +696,23 @@ B hashmap_keys_or_vals(B* vars, usz which) {
   return vars[which];
 }
 
-// Expects already defined: u64* hp, u64 sh, B* keys
+static bool hashmap_eq(bool atm, B x, B k) { // doesn't consume; atm means k is known to be a number or character, so equal can be skipped
+  if (!atm) return equal(x, k);
+  if (isF64(x) & isF64(k)) return x.f==k.f;
+  return x.u==k.u;
+}
+
+// Expects already defined: u64* hp, u64 sh, B* keys, bool atm
 #define HASHMAP_FIND(X, FOUND) \
-  u64 h = bqn_hash(X, wy_secret);    \
-  u64 m = hmask;                     \
-  u64 v = h &~ m;                    \
-  u64 j = h >> sh;                   \
-  u64 u; while ((u=hp[j]) < v) j++;  \
-  while (u < (v|m)) {                \
-    usz i = u&m;                     \
-    if (equal(X, keys[i])) { FOUND } \
-    u = hp[++j];                     \
+  u64 h = bqn_hash(X, wy_secret);             \
+  u64 m = hmask;                              \
+  u64 v = h &~ m;                             \
+  u64 j = h >> sh;                            \
+  u64 u; while ((u=hp[j]) < v) j++;           \
+  while (u < (v|m)) {                         \
+    usz i = u&m;                              \
+    if (hashmap_eq(atm, X, keys[i])) { FOUND } \
+    u = hp[++j];                              \
   }
 // Expects usz i to be the index if new (i in FOUND is index where found)
 #define HASHMAP_INSERT(X, FOUND) \
@@ -709,6 +726,9 @@ B hashmap_build(B key_arr, usz n) {
   HashMap* map = hashmap_alloc(n, sh, sz);
   u64* hp = map->a;
   B* keys = harr_ptr(key_arr);
+  bool atm = true;
+  for (usz i=0; i<n; i++) atm&= !isVal(keys[i]);
+  map->atm = atm;
   for (usz i=0; i<n; i++) {
     B key = keys[i];
     HASHMAP_INSERT(key, thrM("•HashMap: 𝕨 contained duplicate keys");)
@@ -722,7 +742,7 @@ B hashmap_build(B key_arr, usz n) {
 
 B hashmap_lookup(B* vars, B w, B x) {
   HashMap* map = c(HashMap, vars[2]);
-  u64* hp = map->a; u64 sh = map->sh;
+  u64* hp = map->a; u64 sh = map->sh; bool atm = map->atm;
   B* keys = harr_ptr(vars[0]);
   HASHMAP_FIND(x, dec(w); dec(x); return inc(harr_ptr(vars[1])[i]);)
   if (q_N(w)) thrM("(hashmap).Get: key not found");
@@ -731,7 +751,8 @@ B hashmap_lookup(B* vars, B w, B x) {
 
 void hashmap_set(B* vars, B w, B x) {
   HashMap* map = c(HashMap, vars[2]);
-  u64* hp = map->a; u64 sh = map->sh;
+  if (isVal(w)) map->atm = 0;
+  u64* hp = map->a; u64 sh = map->sh; bool atm = map->atm;
   usz i = IA(vars[0]);
   B* keys = harr_ptr(vars[0]);
   HASHMAP_INSERT(
@@ -749,12 +770,11 @@ void hashmap_set(B* vars, B w, B x) {
   vars[1] = vec_addN(vars[1], x);
 }
 
-void hashmap_delete(B* vars, B x) {
+static bool hashmap_remove(B* vars, B x) { // doesn't consume; returns whether x was present
   HashMap* map = c(HashMap, vars[2]);
-  u64* hp = map->a; u64 sh = map->sh;
+  u64* hp = map->a; u64 sh = map->sh; bool atm = map->atm;
   B kb = vars[0]; B* keys = harr_ptr(kb);
   HASHMAP_FIND(x,
-    dec(x);
     do {
       u64 jp=j; j++;
       u=hp[j]; if (u>>sh==j) u=empty;
@@ -766,7 +786,76 @@ void hashmap_delete(B* vars, B x) {
     usz p = --(map->pop); dec(keys[i]); keys[i]=bi_N;
     B* s = harr_ptr(vb)+i; dec(*s); *s=bi_N;
     if (p==0 || p+32 < IA(kb)/2) hashmap_compact(vars);
-    return;
+    return true;
   )
-  thrM("(hashmap).Delete: key not found");
+  return false;
+}
+void hashmap_delete(B* vars, B x) {
+  if (!hashmap_remove(vars, x)) thrM("(hashmap).Delete: key not found");
+  dec(x);
+}
+
+// Batch versions of the above, taking lists of keys; typed key lists are read element-wise without creating an HArr
+static void hashmap_keyList(char* name, B x) {
+  if (!isArr(x) || RNK(x)!=1) thrF("(hashmap).%S: Keys must be a list (%H≡≢𝕩)", name, x);
+}
+B hashmap_lookupAll(B* vars, B w, B x) { // w is bi_N or the default for missing keys
+  hashmap_keyList("GetAll", x);
+  HashMap* map = c(HashMap, vars[2]);
+  u64* hp = map->a; u64 sh = map->sh; bool atm = map->atm;
+  B* keys = harr_ptr(vars[0]);
+  B* vals = harr_ptr(vars[1]);
+  usz n = IA(x); SGetU(x)
+  M_HARR(r, n)
+  for (usz k=0; k<n; k++) {
+    B xk = GetU(x, k);
+    HASHMAP_FIND(xk, HARR_ADD(r, k, inc(vals[i])); goto next;)
+    if (q_N(w)) { HARR_ABANDON(r); decG(x); thrM("(hashmap).GetAll: key not found"); }
+    HARR_ADD(r, k, inc(w));
+    next:;
+  }
+  dec(w); decG(x);
+  return HARR_FV(r);
+}
+
+B hashmap_hasAll(B* vars, B x) {
+  hashmap_keyList("HasAll", x);
+  HashMap* map = c(HashMap, vars[2]);
+  u64* hp = map->a; u64 sh = map->sh; bool atm = map->atm;
+  B* keys = harr_ptr(vars[0]);
+  usz n = IA(x); SGetU(x)
+  u64* rp; B r = m_bitarrv(&rp, n);
+  for (usz k=0; k<n; k++) {
+    B xk = GetU(x, k);
+    bool f = false;
+    HASHMAP_FIND(xk, f = true; break;)
+    bitp_set(rp, k, f);
+  }
+  decG(x);
+  return r;
+}
+
+void hashmap_setAll(B* vars, B w, B x) {
+  hashmap_keyList("SetAll", w);
+  if (!isArr(x) || RNK(x)!=1 || IA(x)!=IA(w)) thrF("(hashmap).SetAll: 𝕩 must be a list with the same length as 𝕨 (%H≡≢𝕨, %H≡≢𝕩)", w, x);
+  usz n = IA(w); SGet(w) SGet(x)
+  HashMap* map = c(HashMap, vars[2]);
+  if ((map->pop+n)>>(64-1-map->sh)) { // grow the table up front to the load •HashMap starts with, instead of repeatedly while inserting
+    vars[2] = bi_N;
+    do map = hashmap_resize(map); while ((map->pop+n)>>(64-1-map->sh));
+    vars[2] = tag(map, OBJ_TAG);
+  }
+  for (usz k=0; k<n; k++) hashmap_set(vars, Get(w, k), Get(x, k));
+  decG(w); decG(x);
+}
+
+void hashmap_deleteAll(B* vars, B x) {
+  hashmap_keyList("DeleteAll", x);
+  B has = hashmap_hasAll(vars, incG(x));
+  bool all = bit_sum(bitany_ptr(has), IA(x)) == IA(x);
+  decG(has);
+  if (!all) { decG(x); thrM("(hashmap).DeleteAll: key not found"); }
+  usz n = IA(x); SGetU(x)
+  for (usz k=0; k<n; k++) hashmap_remove(vars, GetU(x, k)); // repeated keys were removed by their first occurrence
+  decG(x);
 }
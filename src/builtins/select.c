@@ -141,6 +141,10 @@ B select_c2(B t, B w, B x) {
   if (isAtm(x)) thrM("⊏: 𝕩 cannot be an atom");
   ur xr = RNK(x);
   if (xr==0) thrM("⊏: 𝕩 cannot be a unit");
+  if (isStrList(x) && xr==1) {
+    B r = strlist_from(w, x);
+    if (!q_N(r)) { decG(w); decG(x); return r; }
+  }
   if (isAtm(w)) {
     watom:;
     usz xn = *SH(x);
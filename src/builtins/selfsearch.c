@@ -35,6 +35,7 @@
 #include "../utils/hash.h"
 #include "../utils/talloc.h"
 #include "../utils/calls.h"
+#include "../builtins.h"
 
 extern B shape_c1(B, B);
 extern B slash_c2(B, B, B);
@@ -150,6 +151,7 @@ B memberOf_c1(B t, B x) {
   if (isAtm(x) || RNK(x)==0) thrM("∊: Argument cannot have rank 0");
   u64 n = *SH(x);
   if (n<=1) { decG(x); return n ? taga(arr_shVec(allOnes(1))) : emptyIVec(); }
+  if (isStrList(x) && RNK(x)==1 && n<I32_MAX) return strlist_selfSearch(n_memberOf, x);
   
   usz csz = arr_csz(x);
   u8 lw = cellWidthLog(x);
@@ -383,6 +385,7 @@ B indexOf_c1(B t, B x) {
   u64 n = *SH(x);
   if (n<=1) { zeroRes: decG(x); return n? taga(arr_shVec(allZeroes(n))) : emptyIVec(); }
   if (n>(usz)I32_MAX+1) thrM("⊐: Argument length >2⋆31 not supported");
+  if (isStrList(x) && RNK(x)==1 && n<I32_MAX) return strlist_selfSearch(n_indexOf, x);
   
   usz csz = arr_csz(x);
   if (csz==0) goto zeroRes;
@@ -497,6 +500,7 @@ B find_c1(B t, B x) {
   if (isAtm(x) || RNK(x)==0) thrM("⍷: Argument cannot have rank 0");
   usz n = *SH(x);
   if (n<=1) return x;
+  if (isStrList(x) && RNK(x)==1 && n<I32_MAX) return strlist_selfSearch(n_find, x);
   u8 xe = TI(x,elType);
   if (xe==el_bit && RNK(x)==1) {
     u64* xp = bitany_ptr(x);
@@ -355,6 +355,7 @@ B pick_c1(B t, B x) {
     // dec(x);
     // return r;
   }
+  if (isStrList(x)) { B r = strlist_str(x, 0); decG(x); return r; }
   return TO_GET(x, 0);
 }
 
@@ -432,6 +433,7 @@ B pick_c2(B t, B w, B x) {
   if (isNum(w)) {
     if (RNK(x)!=1) thrF("⊑: 𝕩 must be a list when 𝕨 is a number (%H ≡ ≢𝕩)", x);
     usz p = WRAP(o2i64(w), IA(x), thrF("⊑: indexing out-of-bounds (𝕨≡%R, %s≡≠𝕩)", w, iaW));
+    if (isStrList(x)) { B r = strlist_str(x, p); decG(x); return r; }
     return TO_GET(x, p);
   }
   if (!isArr(w)) thrM("⊑: 𝕨 must be a numeric array");
@@ -714,6 +716,7 @@ B drop_c2(B t, B w, B x) {
 
 B join_c1(B t, B x) {
   if (isAtm(x)) thrM("∾: Argument must be an array");
+  if (isStrList(x) && RNK(x)==1 && IA(x)!=0) return strlist_join(x);
 
   ur xr = RNK(x);
   usz xia = IA(x);
@@ -1472,6 +1475,52 @@ B shape_uc1(B t, B o, B x) {
   return truncReshape(shape_uc1_t(c1(o, shape_c1(t, x)), xia), xia, xia, xr, sh);
 }
 
+B shape_ucw(B t, B o, B w, B x) {
+  if (isAtm(x) || RNK(x)==0) { def: return def_fn_ucw(t, o, w, x); }
+  usz xia = IA(x);
+  usz nia = 1;
+  ur nr = 1;
+  if (isF64(w)) {
+    nia = o2s(w);
+  } else {
+    if (isAtm(w) || RNK(w)>1) goto def;
+    if (!elNum(TI(w,elType))) { // may contain a computed axis
+      w = num_squeezeChk(w);
+      if (!elNum(TI(w,elType))) goto def;
+    }
+    nr = IA(w);
+    SGetU(w)
+    for (usz i = 0; i < nr; i++) if (mulOn(nia, o2s(GetU(w, i)))) goto def;
+  }
+  if (nia > xia) goto def; // would repeat elements of 𝕩, so 𝔽's result has to be checked for consistency
+  B rep = c1(o, shape_c2(t, inc(w), incG(x)));
+  bool ok = isArr(rep) && RNK(rep)==nr;
+  if (ok && isF64(w)) ok = IA(rep)==nia;
+  else if (ok) { SGetU(w) usz* rsh = SH(rep); for (usz i = 0; i < nr; i++) ok&= rsh[i]==o2sG(GetU(w, i)); }
+  if (!ok) thrF("𝔽⌾(a⊸⥊)𝕩: 𝔽 must return an array with the same shape as its input (%B ≡ a, %H ≡ shape of result of 𝔽)", w, rep);
+  dec(w);
+  
+  u8 xe = TI(x,elType);
+  u8 re = el_or(xe, TI(rep,elType));
+  if (reusable(x) && re==xe && (xe==el_B? TY(x)==t_harr : xe!=el_bit && TY(x)==el2t(xe))) { // write ⥊rep over the start of x
+    x = REUSE(x);
+    if (xe==el_B) {
+      B* xp = harr_ptr(x);
+      for (usz i = 0; i < nia; i++) dec(xp[i]);
+      COPY_TO(xp, el_B, 0, rep, 0, nia);
+    } else {
+      COPY_TO(tyarr_ptr(x), xe, 0, rep, 0, nia);
+    }
+    decG(rep);
+    return x;
+  }
+  MAKE_MUT_INIT(r, xia, re? re : el_i8); MUTG_INIT(r);
+  mut_copyG(r, 0, rep, 0, nia);
+  mut_copyG(r, nia, x, nia, xia-nia);
+  decG(rep);
+  B rb = mut_fcd(r, x);
+  return re==el_bit? taga(cpyBitArr(rb)) : rb;
+}
 
 B reverse_ix(B t, B w, B x) {
   if (isAtm(x) || RNK(x)==0) thrM("⌽⁼: 𝕩 must have rank at least 1");
@@ -1511,6 +1560,7 @@ void sfns_init(void) {
   c(BFn,bi_pick)->ucw = pick_ucw;
   c(BFn,bi_select)->ucw = select_ucw; // TODO move to new init fn
   c(BFn,bi_shape)->uc1 = shape_uc1;
+  c(BFn,bi_shape)->ucw = shape_ucw;
   c(BFn,bi_take)->ucw = take_ucw;
   c(BFn,bi_drop)->ucw = drop_ucw;
   c(BFn,bi_lt)->im = enclose_im;
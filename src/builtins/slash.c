@@ -69,13 +69,6 @@
 #include "../utils/talloc.h"
 #include "../builtins.h"
 
-#ifdef __BMI2__
-  #if !SLOW_PDEP
-    #define FAST_PDEP 1
-  #endif
-  #include <immintrin.h>
-#endif
-
 #if !USE_VALGRIND
   #define rand_popc64(X) POPC(X)
 #endif
@@ -1035,9 +1028,49 @@ B slash_ucw(B t, B o, B w, B x) {
   B rep = c1(o, arg);
   if (isAtm(rep) || RNK(rep)!=1 || IA(rep) != argIA) thrF("𝔽⌾(a⊸/)𝕩: 𝔽 must return an array with the same shape as its input (expected ⟨%s⟩, got %H)", argIA, rep);
   u8 re = el_or(TI(x,elType), TI(rep,elType));
-  MAKE_MUT_INIT(r, ia, re? re : 1);
   usz repI = 0;
   bool wb = TI(w,elType) == el_bit;
+  if (wb && reusable(x) && (re==el_B? TY(x)==t_harr : re!=el_bit && TY(x)==el2t(re))) { // write the replacement elements over x
+    u64* d = bitany_ptr(w);
+    x = REUSE(x);
+    if (re==el_B) {
+      B* xp = harr_ptr(x);
+      SGet(rep)
+      for (usz i = 0; i < ia; i++) if (bitp_get(d, i)) { dec(xp[i]); xp[i] = Get(rep, repI++); }
+      goto inplace_ret;
+    }
+    void* xp = tyarr_ptr(x);
+    switch (re) { default: UD;
+      case el_i8:  rep = toI8Any(rep);  goto inplace_u8;
+      case el_c8:  rep = toC8Any(rep);  goto inplace_u8;
+      case el_i16: rep = toI16Any(rep); goto inplace_u16;
+      case el_c16: rep = toC16Any(rep); goto inplace_u16;
+      case el_i32: rep = toI32Any(rep); goto inplace_u32;
+      case el_c32: rep = toC32Any(rep); goto inplace_u32;
+      case el_f64: rep = toF64Any(rep); goto inplace_u64;
+    }
+    
+    #define IMPL(T) do {            \
+      T* np = tyany_ptr(rep);       \
+      for (usz b = 0; b < BIT_N(ia); b++) { \
+        u64 v = d[b];               \
+        if (b == ia/64) v&= (1ULL<<(ia%64)) - 1; \
+        while (v) { ((T*)xp)[b*64 + CTZ(v)] = np[repI++]; v&= v-1; } \
+      }                             \
+      goto inplace_ret;             \
+    } while(0)
+    
+    inplace_u8:  IMPL(u8);
+    inplace_u16: IMPL(u16);
+    inplace_u32: IMPL(u32);
+    inplace_u64: IMPL(u64);
+    #undef IMPL
+    
+    inplace_ret:;
+    decG(w); decG(rep);
+    return x;
+  }
+  MAKE_MUT_INIT(r, ia, re? re : 1);
   if (wb && re!=el_B) {
     u64* d = bitany_ptr(w);
     void* rp = r->a;
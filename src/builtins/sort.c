@@ -25,6 +25,106 @@ static NOINLINE void generic_grade(B x, usz ia, B r, i32* rp, void (*fn)(BI32p*,
   TFREE(tmp);
 }
 
+// Lists of strings: multikey quicksort (Bentley & Sedgewick)
+// Partitions on the character at depth d into <, =, and > parts, and only
+// the = part moves on to depth d+1, so a common prefix is read once per
+// string rather than once per comparison. Strings are read in place, in
+// any mix of character widths, with the end of a string below any
+// character, which gives the same order as compare. Equal strings are put
+// in index order at the end, so grades are stable. The rows of a character
+// matrix are sorted the same way, read from the matrix directly.
+typedef struct StrV { void* p; usz n; u8 w; } StrV; // a string's characters, and their width in bytes
+
+static bool str_views(B x, usz n, StrV* v) { // whether the n elements of x are all strings (character lists, or empty lists), filling v with them
+  if (isStrList(x)) {
+    StrList* xs = c(StrList,x);
+    u8 w = elWidth(TI(xs->chars,elType));
+    u8* p = tyany_ptr(xs->chars);
+    for (usz i = 0; i < n; i++) v[i] = (StrV){ p + xs->off[i]*(u64)w, xs->off[i+1]-xs->off[i], w };
+    return true;
+  }
+  SGetU(x)
+  for (usz i = 0; i < n; i++) {
+    B c = GetU(x,i);
+    if (!isArr(c) || RNK(c)!=1) return false;
+    usz cn = IA(c);
+    if (cn==0) { v[i] = (StrV){ NULL, 0, 1 }; continue; }
+    u8 ce = TI(c,elType);
+    if (!elChr(ce)) return false;
+    v[i] = (StrV){ tyany_ptr(c), cn, elWidth(ce) };
+  }
+  return true;
+}
+static u32 str_at(StrV s, usz i) {
+  switch (s.w) { default: UD;
+    case 1: return ((u8* )s.p)[i];
+    case 2: return ((u16*)s.p)[i];
+    case 4: return ((u32*)s.p)[i];
+  }
+}
+static i64 str_key(StrV s, usz d) { return d<s.n? (i64)str_at(s, d) : -1; }
+static i32 str_cmp(StrV a, StrV b, usz d) { // compare of a and b, given that they match before index d
+  usz n = a.n<b.n? a.n : b.n;
+  if (a.w==1 && b.w==1) {
+    if (d<n) { int c = memcmp((u8*)a.p+d, (u8*)b.p+d, n-d); if (c) return c<0? -1 : 1; }
+  } else {
+    for (usz i = d; i < n; i++) { u32 ca=str_at(a,i), cb=str_at(b,i); if (ca!=cb) return ca<cb? -1 : 1; }
+  }
+  return ICMP(a.n, b.n);
+}
+
+#define SORT_CMP(W, X) ((W) - (i64)(X))
+#define SORT_NAME idx
+#define SORT_TYPE i32
+#include "sortTemplate.h"
+
+static void str_mkq(StrV* v, i32* g, usz n, usz d, i64 s) { // sort indices g by the strings they select, which match before depth d; s is 1 for ascending and -1 for descending
+  while (n > 1) {
+    if (n < 12) {
+      for (usz i = 1; i < n; i++) {
+        i32 c = g[i]; usz j = i;
+        while (j>0) { i32 o=g[j-1]; i32 r = s*str_cmp(v[o], v[c], d); if (r<0 || (r==0 && o<c)) break; g[j] = o; j--; }
+        g[j] = c;
+      }
+      return;
+    }
+    i64 k0 = s*str_key(v[g[0]], d), k1 = s*str_key(v[g[n/2]], d), k2 = s*str_key(v[g[n-1]], d);
+    i64 p = k0<k1? (k1<k2? k1 : k0<k2? k2 : k0) : (k0<k2? k0 : k1<k2? k2 : k1);
+    usz lt = 0, i = 0, gt = n;
+    while (i < gt) {
+      i64 k = s*str_key(v[g[i]], d);
+      if      (k<p) { i32 t=g[lt]; g[lt++]=g[i]; g[i++]=t; }
+      else if (k>p) { i32 t=g[--gt]; g[gt]=g[i]; g[i]=t; }
+      else i++;
+    }
+    str_mkq(v, g, lt, d, s);
+    str_mkq(v, g+gt, n-gt, d, s);
+    g+= lt; n = gt-lt;
+    if (p == -s) { idx_tim_sort(g, n); return; } // all ended here, so they're equal
+    d++;
+  }
+}
+static bool str_grade(B x, usz n, i32* rp, bool down) { // grade of a list of n strings into rp, or false if x isn't one
+  TALLOC(StrV, v, n);
+  bool ok = str_views(x, n, v);
+  if (ok) {
+    for (usz i = 0; i < n; i++) rp[i] = i;
+    str_mkq(v, rp, n, 0, down? -1 : 1);
+  }
+  TFREE(v);
+  return ok;
+}
+
+static void str_gradeRows(B x, usz n, i32* rp, bool down) { // grade of the n rows of a character matrix into rp, reading them in place
+  TALLOC(StrV, v, n);
+  u8 w = elWidth(TI(x,elType));
+  usz csz = arr_csz(x);
+  u8* xp = tyany_ptr(x);
+  for (usz i = 0; i < n; i++) { v[i] = (StrV){ xp + i*(u64)csz*w, csz, w }; rp[i] = i; }
+  str_mkq(v, rp, n, 0, down? -1 : 1);
+  TFREE(v);
+}
+
 #define GRADE_UD(U,D) U
 #include "grade.h"
 #define GRADE_UD(U,D) D
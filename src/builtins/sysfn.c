@@ -14,6 +14,7 @@
   #include "../windows/getline.c"
 #endif
 #include <errno.h>
+#include <math.h>
 
 static bool eqStr(B w, u32* x) {
   if (isAtm(w) || RNK(w)!=1) return false;
@@ -333,6 +334,9 @@ STATIC_GLOBAL Body* rand_ns;
 STATIC_GLOBAL B rand_rangeName;   STATIC_GLOBAL NFnDesc* rand_rangeDesc;
 STATIC_GLOBAL B rand_dealName;    STATIC_GLOBAL NFnDesc* rand_dealDesc;
 STATIC_GLOBAL B rand_subsetName;  STATIC_GLOBAL NFnDesc* rand_subsetDesc;
+STATIC_GLOBAL NFnDesc* rand_normalDesc;
+STATIC_GLOBAL NFnDesc* rand_exponentialDesc;
+STATIC_GLOBAL NFnDesc* rand_shuffleDesc;
 #define RAND_START Scope* sc = c(NS,nfn_objU(t))->sc; \
                    u64 seed = sc->vars[0].u | sc->vars[1].u<<32;
 #define RAND_END sc->vars[0].u = seed>>32; \
@@ -345,23 +349,41 @@ B rand_range_c1(B t, B x) {
   RAND_END;
   return xv? m_f64(wy2u0k(rnd, xv)) : m_f64(wy2u01(rnd));
 }
-B rand_range_c2(B t, B w, B x) {
+static usz rand_shapeIA(B w, char* name, char* arg) { // element count of a result with shape w, which is a number or list; doesn't consume
+  if (!isArr(w)) return o2s(w);
+  if (RNK(w) > 1) thrF("(rand).%S: %U must be a valid shape", name, arg);
+  SGetU(w);
+  usz wia = IA(w);
   usz am = 1;
-  i64 max = o2i64(x);
+  bool bad=false, good=false;
+  for (u64 i = 0; i < wia; i++) {
+    usz c = o2s(GetU(w, i));
+    bad|= mulOn(am, c);
+    good|= c==0;
+  }
+  if (bad && !good) thrOOM();
+  return am;
+}
+static B rand_shaped(Arr* r, B w, char* name, char* arg) { // gives r shape w, which was checked by rand_shapeIA; consumes w
   if (isArr(w)) {
-    if (RNK(w) > 1) thrM("(rand).Range: 𝕨 must be a valid shape");
-    SGetU(w);
     usz wia = IA(w);
-    bool bad=false, good=false;
-    for (u64 i = 0; i < wia; i++) {
-      usz c = o2s(GetU(w, i));
-      bad|= mulOn(am, c);
-      good|= c==0;
+    if (wia<2) {
+      arr_rnk01(r, wia);
+    } else {
+      if (wia>UR_MAX) thrF("(rand).%S: Result rank too large (%s≡≢%U)", name, wia, arg);
+      usz* sh = arr_shAlloc(r, wia);
+      SGetU(w);
+      for (usz i = 0; i < wia; i++) sh[i] = o2sG(GetU(w, i));
     }
-    if (bad && !good) thrOOM();
   } else {
-    am = o2s(w);
+    arr_shVec(r);
   }
+  dec(w);
+  return taga(r);
+}
+B rand_range_c2(B t, B w, B x) {
+  i64 max = o2i64(x);
+  usz am = rand_shapeIA(w, "Range", "𝕨");
   
   RAND_START;
   Arr* r;
@@ -411,21 +433,7 @@ B rand_range_c2(B t, B w, B x) {
   }
 
   RAND_END;
-  if (isArr(w)) {
-    usz wia = IA(w);
-    if (wia<2) {
-      arr_rnk01(r, wia);
-    } else {
-      if (wia>UR_MAX) thrF("(rand).Range: Result rank too large (%s≡≢𝕨)", wia);
-      usz* sh = arr_shAlloc(r, wia);
-      SGetU(w);
-      for (usz i = 0; i < wia; i++) sh[i] = o2sG(GetU(w, i));
-    }
-  } else {
-    arr_shVec(r);
-  }
-  dec(w);
-  return taga(r);
+  return rand_shaped(r, w, "Range", "𝕨");
 }
 
 extern GLOBAL Arr* bitUD[3]; // from fns.c
@@ -573,6 +581,7 @@ B rand_deal_c2(B t, B w, B x) {
 
 B ud_c1(B t, B x);
 B slash_c1(B t, B x);
+B select_c2(B t, B w, B x);
 extern void filter_ne_i32(i32* dst, i32* src, usz len, usz sum, i32 val); // slash.c
 
 B rand_subset_c2(B t, B w, B x) {
@@ -630,6 +639,107 @@ B rand_subset_c2(B t, B w, B x) {
   return r;
 }
 
+// Ziggurat tables (Marsaglia & Tsang) for Normal and Exponential: layer i is sampled as x = u×W[i] from 53 random bits u, and accepted right away if u < K[i], i.e. if x is below the next layer's edge
+#define ZIG_N_LAYERS 128
+#define ZIG_N_R 3.442619855899
+#define ZIG_N_V 9.91256303526217e-3
+#define ZIG_E_LAYERS 256
+#define ZIG_E_R 7.697117470131487
+#define ZIG_E_V 3.949659822581572e-3
+STATIC_GLOBAL f64 zigN_W[ZIG_N_LAYERS]; STATIC_GLOBAL f64 zigN_F[ZIG_N_LAYERS+1]; STATIC_GLOBAL u64 zigN_K[ZIG_N_LAYERS];
+STATIC_GLOBAL f64 zigE_W[ZIG_E_LAYERS]; STATIC_GLOBAL f64 zigE_F[ZIG_E_LAYERS+1]; STATIC_GLOBAL u64 zigE_K[ZIG_E_LAYERS];
+static f64 zig_normalF(f64 x) { return exp(-0.5*x*x); }
+static f64 zig_normalFInv(f64 y) { return sqrt(-2*log(y)); }
+static f64 zig_expF(f64 x) { return exp(-x); }
+static f64 zig_expFInv(f64 y) { return -log(y); }
+static void zig_init(usz n, f64 r, f64 v, f64 (*f)(f64), f64 (*fInv)(f64), f64* W, f64* F, u64* K) {
+  TALLOC(f64, x, n+1); // layer edges; layer 0 is the base rectangle plus the tail, as a rectangle of the same area
+  x[0] = v/f(r); x[1] = r; x[n] = 0;
+  for (usz i = 1; i < n-1; i++) x[i+1] = fInv(v/x[i] + f(x[i]));
+  for (usz i = 0; i < n; i++) {
+    W[i] = x[i] / (f64)(1ULL<<53);
+    K[i] = (u64)(x[i+1]/x[i] * (f64)(1ULL<<53));
+  }
+  for (usz i = 0; i <= n; i++) F[i] = f(x[i]);
+  TFREE(x);
+}
+
+static inline f64 rand_normal(u64* seed) {
+  while (true) {
+    u64 rnd = wyrand(seed);
+    usz i = rnd & (ZIG_N_LAYERS-1);
+    u64 u = rnd >> 11;
+    f64 x = u * zigN_W[i];
+    if (LIKELY(u < zigN_K[i])) return rnd&ZIG_N_LAYERS? -x : x;
+    if (i==0) { // tail beyond ZIG_N_R
+      f64 a, b;
+      do {
+        a = -log(1-wy2u01(wyrand(seed))) / ZIG_N_R;
+        b = -log(1-wy2u01(wyrand(seed)));
+      } while (b+b < a*a);
+      x = ZIG_N_R + a;
+      return rnd&ZIG_N_LAYERS? -x : x;
+    }
+    if (zigN_F[i] + wy2u01(wyrand(seed))*(zigN_F[i+1]-zigN_F[i]) < zig_normalF(x)) return rnd&ZIG_N_LAYERS? -x : x;
+  }
+}
+static inline f64 rand_exponential(u64* seed) {
+  while (true) {
+    u64 rnd = wyrand(seed);
+    usz i = rnd & (ZIG_E_LAYERS-1);
+    u64 u = rnd >> 11;
+    f64 x = u * zigE_W[i];
+    if (LIKELY(u < zigE_K[i])) return x;
+    if (i==0) return ZIG_E_R - log(1-wy2u01(wyrand(seed))); // tail beyond ZIG_E_R; memoryless
+    if (zigE_F[i] + wy2u01(wyrand(seed))*(zigE_F[i+1]-zigE_F[i]) < zig_expF(x)) return x;
+  }
+}
+
+#define RAND_DIST(NAME, DESC, GEN) \
+B rand_##NAME##_c1(B t, B x) {                     \
+  usz am = rand_shapeIA(x, DESC, "𝕩");             \
+  f64* rp; Arr* r = m_f64arrp(&rp, am);            \
+  RAND_START;                                      \
+  for (usz i = 0; i < am; i++) rp[i] = GEN(&seed); \
+  RAND_END;                                        \
+  return rand_shaped(r, x, DESC, "𝕩");             \
+}
+RAND_DIST(normal, "Normal", rand_normal)
+RAND_DIST(exponential, "Exponential", rand_exponential)
+#undef RAND_DIST
+
+#define SHUFFLE(T) for (usz i = n-1; i > 0; i--) { usz j = wy2u0k(wyrand(&seed), i+1); T s = ((T*)xp)[i]; ((T*)xp)[i] = ((T*)xp)[j]; ((T*)xp)[j] = s; }
+B rand_shuffle_c1(B t, B x) {
+  if (isAtm(x) || RNK(x)==0) thrM("(rand).Shuffle: 𝕩 must have rank at least 1");
+  usz n = *SH(x);
+  if (n<=1) return x;
+  u8 xe = TI(x,elType);
+  u8 xt = TY(x);
+  if (RNK(x)>1 || xe==el_bit || (xe==el_B && xt!=t_harr && xt!=t_hslice)) { // shuffle cells with a permutation
+    B p = rand_deal_c1(t, m_usz(n));
+    return C2(select, p, x);
+  }
+  if (!reusable(x) || xt!=(xe==el_B? t_harr : el2t(xe))) { // otherwise shuffle in place
+    switch (xe) { default: UD;
+      case el_i8:  x = taga(cpyI8Arr (x)); break; case el_c8:  x = taga(cpyC8Arr (x)); break;
+      case el_i16: x = taga(cpyI16Arr(x)); break; case el_c16: x = taga(cpyC16Arr(x)); break;
+      case el_i32: x = taga(cpyI32Arr(x)); break; case el_c32: x = taga(cpyC32Arr(x)); break;
+      case el_f64: x = taga(cpyF64Arr(x)); break; case el_B:   x = taga(cpyHArr  (x)); break;
+    }
+  } else x = REUSE(x);
+  void* xp = xe==el_B? (void*)harr_ptr(x) : tyarr_ptr(x);
+  RAND_START;
+  switch (arrTypeWidthLog(TY(x))) { default: UD;
+    case 0: SHUFFLE(u8); break;
+    case 1: SHUFFLE(u16); break;
+    case 2: SHUFFLE(u32); break;
+    case 3: SHUFFLE(u64); break;
+  }
+  RAND_END;
+  return x;
+}
+#undef SHUFFLE
+
 #if USE_VALGRIND
 u64 vgRandSeed;
 u64 vgRand64Range(u64 range) {
@@ -644,19 +754,24 @@ static NOINLINE void rand_init() {
   #if USE_VALGRIND
     vgRandSeed = nsTime();
   #endif
-  rand_ns = m_nnsDesc("seed1", "seed2", "range", "deal", "subset");
+  rand_ns = m_nnsDesc("seed1", "seed2", "range", "deal", "subset", "normal", "exponential", "shuffle");
   NSDesc* d = rand_ns->nsDesc;
   d->expGIDs[0] = d->expGIDs[1] = -1;
   rand_rangeName  = m_c8vec_0("range");  gc_add(rand_rangeName);  rand_rangeDesc  = registerNFn(m_c8vec_0("(rand).Range"), rand_range_c1, rand_range_c2);
   rand_dealName   = m_c8vec_0("deal");   gc_add(rand_dealName);   rand_dealDesc   = registerNFn(m_c8vec_0("(rand).Deal"),   rand_deal_c1, rand_deal_c2);
   rand_subsetName = m_c8vec_0("subset"); gc_add(rand_subsetName); rand_subsetDesc = registerNFn(m_c8vec_0("(rand).Subset"),       c1_bad, rand_subset_c2);
+  rand_normalDesc      = registerNFn(m_c8vec_0("(rand).Normal"),      rand_normal_c1,      c2_bad);
+  rand_exponentialDesc = registerNFn(m_c8vec_0("(rand).Exponential"), rand_exponential_c1, c2_bad);
+  rand_shuffleDesc     = registerNFn(m_c8vec_0("(rand).Shuffle"),     rand_shuffle_c1,     c2_bad);
+  zig_init(ZIG_N_LAYERS, ZIG_N_R, ZIG_N_V, zig_normalF, zig_normalFInv, zigN_W, zigN_F, zigN_K);
+  zig_init(ZIG_E_LAYERS, ZIG_E_R, ZIG_E_V, zig_expF,    zig_expFInv,    zigE_W, zigE_F, zigE_K);
 }
 B makeRand_c1(B t, B x) {
   if (!isNum(x)) thrM("•MakeRand: 𝕩 must be a number");
   if (rand_ns==NULL) rand_init();
-  B r = m_nns(rand_ns, b(x.u>>32), b(x.u&0xFFFFFFFF), m_nfn(rand_rangeDesc, bi_N), m_nfn(rand_dealDesc, bi_N), m_nfn(rand_subsetDesc, bi_N));
+  B r = m_nns(rand_ns, b(x.u>>32), b(x.u&0xFFFFFFFF), m_nfn(rand_rangeDesc, bi_N), m_nfn(rand_dealDesc, bi_N), m_nfn(rand_subsetDesc, bi_N), m_nfn(rand_normalDesc, bi_N), m_nfn(rand_exponentialDesc, bi_N), m_nfn(rand_shuffleDesc, bi_N));
   Scope* sc = c(NS,r)->sc;
-  for (i32 i = 2; i < 5; i++) nfn_swapObj(sc->vars[i], incG(r));
+  for (i32 i = 2; i < 8; i++) nfn_swapObj(sc->vars[i], incG(r));
   return r;
 }
 STATIC_GLOBAL B randNS;
@@ -725,6 +840,10 @@ STATIC_GLOBAL NFnDesc* hashmap_deleteDesc;
 STATIC_GLOBAL NFnDesc* hashmap_countDesc;
 STATIC_GLOBAL NFnDesc* hashmap_keysDesc;
 STATIC_GLOBAL NFnDesc* hashmap_valuesDesc;
+STATIC_GLOBAL NFnDesc* hashmap_getAllDesc;
+STATIC_GLOBAL NFnDesc* hashmap_hasAllDesc;
+STATIC_GLOBAL NFnDesc* hashmap_setAllDesc;
+STATIC_GLOBAL NFnDesc* hashmap_deleteAllDesc;
 // Hash object handling defined in search.c
 extern B hashmap_build(B keys, usz n);
 extern B hashmap_lookup(B* vars, B w, B x);
@@ -732,6 +851,10 @@ extern void hashmap_set(B* vars, B w, B x);
 extern void hashmap_delete(B* vars, B x);
 extern usz hashmap_count(B hash);
 extern B hashmap_keys_or_vals(B* vars, usz which);
+extern B hashmap_lookupAll(B* vars, B w, B x);
+extern B hashmap_hasAll(B* vars, B x);
+extern void hashmap_setAll(B* vars, B w, B x);
+extern void hashmap_deleteAll(B* vars, B x);
 #define VARS c(NS,nfn_objU(t))->sc->vars
 B hashmap_get_c1(B t, B x     ) { return hashmap_lookup(VARS, bi_N, x); }
 B hashmap_get_c2(B t, B w, B x) { return hashmap_lookup(VARS, w,    x); }
@@ -745,9 +868,14 @@ B hashmap_has_c1(B t, B x) {
 B hashmap_count_c1(B t, B x) { dec(x); return m_usz(hashmap_count(VARS[2])); }
 B hashmap_keys_c1  (B t, B x) { dec(x); return inc(hashmap_keys_or_vals(VARS, 0)); }
 B hashmap_values_c1(B t, B x) { dec(x); return inc(hashmap_keys_or_vals(VARS, 1)); }
+B hashmap_getAll_c1(B t, B x     ) { return hashmap_lookupAll(VARS, bi_N, x); }
+B hashmap_getAll_c2(B t, B w, B x) { return hashmap_lookupAll(VARS, w,    x); }
+B hashmap_hasAll_c1(B t, B x     ) { return hashmap_hasAll(VARS, x); }
+B hashmap_setAll_c2(B t, B w, B x) { hashmap_setAll(VARS, w, x); return inc(nfn_objU(t)); }
+B hashmap_deleteAll_c1(B t, B x  ) { hashmap_deleteAll(VARS, x); return inc(nfn_objU(t)); }
 #undef VARS
 static NOINLINE void hashmap_init() {
-  hashmap_ns = m_nnsDesc("keylist", "vallist", "hash", "get", "has", "set", "delete", "count", "keys", "values");
+  hashmap_ns = m_nnsDesc("keylist", "vallist", "hash", "get", "has", "set", "delete", "count", "keys", "values", "getall", "hasall", "setall", "deleteall");
   NSDesc* d = hashmap_ns->nsDesc;
   for (usz i = 0; i < 3; i++) d->expGIDs[i] = -1;
   hashmap_getDesc    = registerNFn(m_c8vec_0("(hashmap).Get"),    hashmap_get_c1,    hashmap_get_c2);
@@ -757,6 +885,10 @@ static NOINLINE void hashmap_init() {
   hashmap_countDesc  = registerNFn(m_c8vec_0("(hashmap).Count"),  hashmap_count_c1,  c2_bad);
   hashmap_keysDesc   = registerNFn(m_c8vec_0("(hashmap).Keys"),   hashmap_keys_c1,   c2_bad);
   hashmap_valuesDesc = registerNFn(m_c8vec_0("(hashmap).Values"), hashmap_values_c1, c2_bad);
+  hashmap_getAllDesc    = registerNFn(m_c8vec_0("(hashmap).GetAll"),    hashmap_getAll_c1,    hashmap_getAll_c2);
+  hashmap_hasAllDesc    = registerNFn(m_c8vec_0("(hashmap).HasAll"),    hashmap_hasAll_c1,    c2_bad);
+  hashmap_setAllDesc    = registerNFn(m_c8vec_0("(hashmap).SetAll"),    c1_bad,               hashmap_setAll_c2);
+  hashmap_deleteAllDesc = registerNFn(m_c8vec_0("(hashmap).DeleteAll"), hashmap_deleteAll_c1, c2_bad);
 }
 B hashMap_c2(B t, B w, B x) {
   if (!isArr(w) || RNK(w)!=1 || !isArr(x) || RNK(x)!=1) thrF("•HashMap: Arguments must be lists (%H≡≢𝕨, %H≡≢𝕩)", w, x);
@@ -765,9 +897,9 @@ B hashMap_c2(B t, B w, B x) {
   if (hashmap_ns==NULL) hashmap_init();
   w = taga(toHArr(w)); x = taga(toHArr(x));
   B h = hashmap_build(w, n);
-  B ns = m_nns(hashmap_ns, w, x, h, m_nfn(hashmap_getDesc, bi_N), m_nfn(hashmap_hasDesc, bi_N), m_nfn(hashmap_setDesc, bi_N), m_nfn(hashmap_deleteDesc, bi_N), m_nfn(hashmap_countDesc, bi_N), m_nfn(hashmap_keysDesc, bi_N), m_nfn(hashmap_valuesDesc, bi_N));
+  B ns = m_nns(hashmap_ns, w, x, h, m_nfn(hashmap_getDesc, bi_N), m_nfn(hashmap_hasDesc, bi_N), m_nfn(hashmap_setDesc, bi_N), m_nfn(hashmap_deleteDesc, bi_N), m_nfn(hashmap_countDesc, bi_N), m_nfn(hashmap_keysDesc, bi_N), m_nfn(hashmap_valuesDesc, bi_N), m_nfn(hashmap_getAllDesc, bi_N), m_nfn(hashmap_hasAllDesc, bi_N), m_nfn(hashmap_setAllDesc, bi_N), m_nfn(hashmap_deleteAllDesc, bi_N));
   Scope* sc = c(NS,ns)->sc;
-  for (usz i = 3; i < 10; i++) nfn_swapObj(sc->vars[i], incG(ns));
+  for (usz i = 3; i < 14; i++) nfn_swapObj(sc->vars[i], incG(ns));
   return ns;
 }
 
@@ -814,15 +946,35 @@ B flines_c1(B d, B x) {
 }
 B flines_c2(B d, B w, B x) {
   if (isAtm(x) || RNK(x)!=1) thrM("•file.Lines: 𝕩 must be a list");
-  B s = emptyCVec();
-  usz ia = IA(x);
-  SGet(x)
-  for (u64 i = 0; i < ia; i++) {
-    B l = Get(x, i);
-    if (isAtm(l) || RNK(l)!=1) thrM("•file.Lines: Elements of 𝕩 must be lists of characters");
-    s = vec_join(s, l);
-    //if (windows) s = vec_add(s, m_c32('\r')); TODO figure out whether or not this is a thing that should be done
-    s = vec_addN(s, m_c32('\n'));
+  B s;
+  if (isStrList(x)) { // each string's characters followed by a newline, at the width of the characters
+    StrList* xs = c(StrList,x);
+    usz ia = IA(x);
+    B ch = xs->chars;
+    u8 cw = elWidth(TI(ch,elType));
+    u8* cp = tyany_ptr(ch);
+    u64 rn = 0;
+    for (usz i = 0; i < ia; i++) rn+= xs->off[i+1]-xs->off[i] + 1;
+    u8* rp = m_tyarrv(&s, cw, rn, el2t(TI(ch,elType)));
+    u64 o = 0;
+    for (usz i = 0; i < ia; i++) {
+      usz l = xs->off[i+1]-xs->off[i];
+      memcpy(rp+o*cw, cp+xs->off[i]*(u64)cw, l*(u64)cw);
+      o+= l;
+      switch (cw) { default: UD; case 1: rp[o] = '\n'; break; case 2: ((u16*)rp)[o] = '\n'; break; case 4: ((u32*)rp)[o] = '\n'; break; }
+      o++;
+    }
+  } else {
+    s = emptyCVec();
+    usz ia = IA(x);
+    SGet(x)
+    for (u64 i = 0; i < ia; i++) {
+      B l = Get(x, i);
+      if (isAtm(l) || RNK(l)!=1) thrM("•file.Lines: Elements of 𝕩 must be lists of characters");
+      s = vec_join(s, l);
+      //if (windows) s = vec_add(s, m_c32('\r')); TODO figure out whether or not this is a thing that should be done
+      s = vec_addN(s, m_c32('\n'));
+    }
   }
   dec(x);
   B p = path_rel(nfn_objU(d), w, "•file.Lines");
@@ -1019,6 +1171,7 @@ B toUtf8_c1(B t, B x) {
 
 #if __has_include(<spawn.h>) && __has_include(<fcntl.h>) && __has_include(<sys/wait.h>) && __has_include(<sys/poll.h>) && !WASM
 #define HAS_SH 1
+#define HAS_PROC 1
 #include <spawn.h>
 #include <fcntl.h>
 #include <sys/wait.h>
@@ -1032,13 +1185,83 @@ void shClose(int fd) { if (close(fd)) fatal("bad file descriptor close"); }
 // #define shDbg(...) printf(__VA_ARGS__); fflush(stdout)
 #define shDbg(...)
 
-static i32 sh_core(bool raw, B x, usz xia, B inObj, u64 iLen, B* s_outp, B* s_errp) {
+static void shSetFlags(int fd) { // our side of pipes never blocks because we're working on multiple, and isn't inherited by other children
+  fcntl(fd, F_SETFL, O_NONBLOCK);
+  fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+
+// A child process with pipes to its stdin, stdout & stderr, shared by •SH and •proc
+// Output is read into per-stream buffers whenever anything waits on the process, so a child doesn't block on a full pipe unless a buffer limit is set
+typedef struct ProcObj {
+  struct CustomObj;
+  pid_t pid;
+  int fd[3]; // our ends of the child's stdin, stdout, stderr; -1 once closed
+  bool closeIn; // close stdin once pending input is written
+  bool reaped;
+  i32 code;
+  u64 limit; // maximum number of bytes buffered per output stream
+  u64 inOff;
+  B in; // pending stdin bytes as a c8 list, or bi_N
+  B buf[2]; // unread stdout & stderr
+} ProcObj;
+
+static void proc_visit(Value* v) {
+  ProcObj* p = (ProcObj*)v;
+  mm_visit(p->in); mm_visit(p->buf[0]); mm_visit(p->buf[1]);
+}
+// children whose process object was freed before they exited; they're reaped by proc_reapOrphans, called on every spawn, so they don't stay zombies
+STATIC_GLOBAL pid_t* proc_orphans;
+STATIC_GLOBAL usz proc_orphanAm, proc_orphanCap;
+static void proc_reapOrphans(void) {
+  usz o = 0;
+  for (usz i = 0; i < proc_orphanAm; i++) {
+    int status;
+    if (waitpid(proc_orphans[i], &status, WNOHANG) == 0) proc_orphans[o++] = proc_orphans[i];
+  }
+  proc_orphanAm = o;
+}
+static void proc_freeO(Value* v) {
+  ProcObj* p = (ProcObj*)v;
+  for (i32 i = 0; i < 3; i++) if (p->fd[i]>=0) shClose(p->fd[i]);
+  if (!p->reaped) {
+    int status;
+    if (waitpid(p->pid, &status, WNOHANG) == 0) { // still running; not blocking here, as the child may not exit on its own
+      if (proc_orphanAm == proc_orphanCap) {
+        proc_orphanCap = proc_orphanCap? proc_orphanCap*2 : 16;
+        proc_orphans = realloc(proc_orphans, proc_orphanCap*sizeof(pid_t));
+        if (proc_orphans == NULL) fatal("failed to allocate process list");
+      }
+      proc_orphans[proc_orphanAm++] = p->pid;
+    }
+  }
+  dec(p->in); dec(p->buf[0]); dec(p->buf[1]);
+}
+static void proc_closeFd(ProcObj* p, i32 i) {
+  shClose(p->fd[i]);
+  p->fd[i] = -1;
+}
+static bool proc_tryReap(ProcObj* p, int flags) {
+  int status;
+  if (waitpid(p->pid, &status, flags) != p->pid) return false;
+  p->reaped = true;
+  p->code = WIFEXITED(status)?   WEXITSTATUS(status)
+          : WIFSIGNALED(status)? WTERMSIG(status)+128
+          : -1;
+  return true;
+}
+static bool proc_outRoom(ProcObj* p, i32 i) { return p->fd[i]>=0 && IA(p->buf[i-1]) < p->limit; }
+static bool proc_outStuck(ProcObj* p) { // whether output isn't being read (closed, or buffer full), so exiting must be checked for separately
+  return !proc_outRoom(p,1) || !proc_outRoom(p,2);
+}
+
+static ProcObj* proc_spawn(char* name, B x, u64 limit) { // x is a non-empty list of strings; doesn't consume
+  usz xia = IA(x);
   // allocate args
   TALLOC(char*, argv, xia+1);
   SGetU(x)
   for (u64 i = 0; i < xia; i++) {
     B c = GetU(x, i);
-    if (isAtm(c) || RNK(c)!=1) thrM("•SH: 𝕩 must be a list of strings");
+    if (isAtm(c) || RNK(c)!=1) thrF("%U: 𝕩 must be a list of strings", name);
     u64 len = utf8lenB(c);
     TALLOC(char, cstr, len+1);
     toUTF8(c, cstr);
@@ -1047,15 +1270,23 @@ static i32 sh_core(bool raw, B x, usz xia, B inObj, u64 iLen, B* s_outp, B* s_er
   }
   argv[xia] = NULL;
   
+  proc_reapOrphans();
+  
   // create pipes
-  int p_in[2];
-  int p_out[2];
-  int p_err[2];
-  if (pipe(p_in) || pipe(p_out) || pipe(p_err)) thrM("•SH: Failed to create process: Couldn't create pipes"); // TODO these pipes will easily leak
+  int p_in[2] = {-1, -1};
+  int p_out[2] = {-1, -1};
+  int p_err[2] = {-1, -1};
+  if (pipe(p_in) || pipe(p_out) || pipe(p_err)) {
+    int* ps[] = {p_in, p_out, p_err};
+    for (i32 i = 0; i < 3; i++) for (i32 j = 0; j < 2; j++) if (ps[i][j]>=0) shClose(ps[i][j]);
+    for (u64 i = 0; i < xia; i++) TFREE(argv[i]);
+    TFREE(argv);
+    thrF("%U: Failed to create process: Couldn't create pipes", name);
+  }
   shDbg("pipes: %d %d %d %d %d %d\n", p_in[0], p_in[1], p_out[0], p_out[1], p_err[0], p_err[1]);
-  fcntl(p_in[1], F_SETFL, O_NONBLOCK); // make our side of pipes never block because we're working on multiple
-  fcntl(p_out[0], F_SETFL, O_NONBLOCK);
-  fcntl(p_err[0], F_SETFL, O_NONBLOCK);
+  shSetFlags(p_in[1]);
+  shSetFlags(p_out[0]);
+  shSetFlags(p_err[0]);
   
   posix_spawn_file_actions_t a; posix_spawn_file_actions_init(&a);
   // bind the other ends of pipes to the ones in the new process, and close the originals afterwards
@@ -1065,7 +1296,7 @@ static i32 sh_core(bool raw, B x, usz xia, B inObj, u64 iLen, B* s_outp, B* s_er
   
   // spawn the actual process
   pid_t pid;
-  if(posix_spawnp(&pid, argv[0], &a, NULL, argv, environ) != 0) thrF("•SH: Failed to create process: %S", strerror(errno));
+  int err = posix_spawnp(&pid, argv[0], &a, NULL, argv, environ);
   posix_spawn_file_actions_destroy(&a); // used now
   shClose(p_in[0]); // close the useless pipes on this side
   shClose(p_out[1]);
@@ -1075,81 +1306,196 @@ static i32 sh_core(bool raw, B x, usz xia, B inObj, u64 iLen, B* s_outp, B* s_er
   for (u64 i = 0; i < xia; i++) TFREE(argv[i]);
   TFREE(argv);
   
-  // allocate stdin
-  u64 iOff = 0;
-  char* iBuf;
-  CharBuf iBufRaw;
-  if (iLen>0) {
-    if (raw) {
-      iBufRaw = get_chars(inObj);
-      iBuf = iBufRaw.data;
-    } else {
-      iBuf = TALLOCP(char, iLen);
-      toUTF8(inObj, iBuf);
-    }
-  } else iBuf = "";
-  #define FREE_INPUT do { if (iLen>0) { if (raw) free_chars(iBufRaw); else TFREE(iBuf); } } while(0)
-  
-  bool iDone = false;
-  // allocate output buffer
-  B s_out = emptyCVec();
-  B s_err = emptyCVec();
-  
-  // polling mess
-  const u64 bufsz = 1024;
-  u8* oBuf;
-  B oBufObj = m_c8arrv(&oBuf, bufsz);
-  usz* oBufIA = &a(oBufObj)->ia;
+  if (err != 0) {
+    shClose(p_in[1]); shClose(p_out[0]); shClose(p_err[0]);
+    thrF("%U: Failed to create process: %S", name, strerror(err));
+  }
   
-  pollfd ps[3];
-  i32 plen = 0;
-  i32 err_i, out_i, in_i;
-  ps[err_i = plen++] = (pollfd){.fd=p_err[0], .events=POLLIN};
-  ps[out_i = plen++] = (pollfd){.fd=p_out[0], .events=POLLIN};
-  ps[in_i  = plen++] = (pollfd){.fd=p_in[1], .events=POLLOUT};
+  ProcObj* p = m_customObj(sizeof(ProcObj), proc_visit, proc_freeO);
+  p->pid = pid;
+  p->fd[0] = p_in[1];
+  p->fd[1] = p_out[0];
+  p->fd[2] = p_err[0];
+  p->closeIn = false;
+  p->reaped = false;
+  p->code = -1;
+  p->limit = limit;
+  p->inOff = 0;
+  p->in = bi_N;
+  p->buf[0] = emptyCVec();
+  p->buf[1] = emptyCVec();
+  return p;
+}
+
+// One round of polling over the processes: write pending stdin, read available output into buffers, and reap exited children
+// Waits for at most timeout milliseconds (-1 for no limit) if nothing's ready; children with an output stream that's closed or at its buffer limit are checked on every 10ms
+static void proc_poll(ProcObj** ps, usz n, i32 timeout) {
+  TALLOC(pollfd, fds, n*3);
+  TALLOC(u32, who, n*3); // 3×process index + stream
+  usz m = 0;
+  for (usz i = 0; i < n; i++) {
+    ProcObj* p = ps[i];
+    if (p->fd[0]>=0 && !q_N(p->in)) { who[m] = 3*i;   fds[m++] = (pollfd){.fd=p->fd[0], .events=POLLOUT}; }
+    if (proc_outRoom(p,1))          { who[m] = 3*i+1; fds[m++] = (pollfd){.fd=p->fd[1], .events=POLLIN}; }
+    if (proc_outRoom(p,2))          { who[m] = 3*i+2; fds[m++] = (pollfd){.fd=p->fd[2], .events=POLLIN}; }
+    if (!p->reaped && proc_outStuck(p) && (timeout<0 || timeout>10)) timeout = 10;
+  }
   
-  while (poll(&ps[0], plen - iDone, -1) > 0) {
-    shDbg("next poll; revents: out:%d err:%d in:%d\n", ps[0].revents, ps[1].revents, ps[2].revents);
-    bool any = false;
-    if (ps[out_i].revents & POLLIN) while(true) { i64 len = read(p_out[0], &oBuf[0], bufsz); shDbg("read stdout "N64d"\n",len); if(len<=0) break; else any=true; *oBufIA = len; s_out = vec_join(s_out, incG(oBufObj)); }
-    if (ps[err_i].revents & POLLIN) while(true) { i64 len = read(p_err[0], &oBuf[0], bufsz); shDbg("read stderr "N64d"\n",len); if(len<=0) break; else any=true; *oBufIA = len; s_err = vec_join(s_err, incG(oBufObj)); }
-    if (!iDone && ps[in_i].revents & POLLOUT) {
-      shDbg("writing "N64u"\n", iLen-iOff);
-      ssize_t ww = write(p_in[1], iBuf+iOff, iLen-iOff);
-      shDbg("written %zd/"N64u"\n", ww, iLen-iOff);
-      if (ww >= 0) {
-        iOff+= ww;
-        if (iOff==iLen) { iDone=true; shClose(p_in[1]); FREE_INPUT; shDbg("writing done\n"); }
-        any = true;
+  i32 got = poll(fds, m, timeout);
+  shDbg("polled %d fds, %d ready\n", (int)m, got);
+  if (got>0) {
+    const u64 bufsz = 65536;
+    TALLOC(char, rbuf, bufsz);
+    for (usz j = 0; j < m; j++) {
+      if (!fds[j].revents) continue;
+      ProcObj* p = ps[who[j]/3];
+      u32 s = who[j]%3;
+      if (s==0) {
+        u64 iLen = IA(p->in);
+        ssize_t ww = write(p->fd[0], c8any_ptr(p->in)+p->inOff, iLen-p->inOff);
+        shDbg("written %zd/"N64u"\n", ww, iLen-p->inOff);
+        if (ww >= 0) p->inOff+= ww;
+        else if (errno==EAGAIN || errno==EINTR) continue;
+        if (ww < 0 || p->inOff==iLen) { // done, or the child closed its stdin
+          dec(p->in); p->in = bi_N; p->inOff = 0;
+          if (ww < 0 || p->closeIn) proc_closeFd(p, 0);
+        }
+      } else {
+        u64 room = p->limit - IA(p->buf[s-1]);
+        ssize_t len = read(p->fd[s], rbuf, room<bufsz? room : bufsz);
+        shDbg("read stream %d: %zd\n", (int)s, len);
+        if (len > 0) p->buf[s-1] = vec_join(p->buf[s-1], m_c8vec(rbuf, len));
+        else if (len==0 || (errno!=EAGAIN && errno!=EINTR)) proc_closeFd(p, s);
       }
     }
-    #ifdef __CYGWIN__
-    if (!any) { shDbg("no events despite poll returning; end\n"); break; }
-    #else
-    (void)any;
-    #endif
-    if (ps[out_i].revents & POLLHUP  &&  ps[err_i].revents & POLLHUP) { shDbg("HUP end\n"); break; }
+    TFREE(rbuf);
   }
+  TFREE(fds);
+  TFREE(who);
   
-  // free output buffer
-  assert(reusable(oBufObj));
-  #if VERIFY_TAIL
-  *oBufIA = bufsz;
-  #endif
-  mm_free(v(oBufObj));
-  // free our ends of pipes
-  if (!iDone) { shClose(p_in[1]); FREE_INPUT; shDbg("only got to write "N64u"/"N64u"\n", iOff, iLen); }
-  shClose(p_out[0]);
-  shClose(p_err[0]);
+  for (usz i = 0; i < n; i++) {
+    ProcObj* p = ps[i];
+    if (!p->reaped && proc_outStuck(p)) proc_tryReap(p, WNOHANG);
+  }
+}
+
+static void proc_write(ProcObj* p, B bytes, bool close) { // consumes bytes, a c8 list
+  p->closeIn|= close;
+  if (IA(bytes)>0 && p->fd[0]>=0) {
+    if (q_N(p->in)) p->in = bytes;
+    else p->in = vec_join(p->in, bytes);
+    while (!q_N(p->in)) proc_poll(&p, 1, -1);
+  } else dec(bytes);
+  if (close && p->fd[0]>=0) proc_closeFd(p, 0);
+}
+
+static i32 proc_wait(ProcObj* p) {
+  while (!p->reaped) proc_poll(&p, 1, -1);
+  return p->code;
+}
+
+static i32 sh_core(bool raw, B x, usz xia, B inObj, u64 iLen, B* s_outp, B* s_errp) {
+  ProcObj* p = proc_spawn("•SH", x, U64_MAX);
   
-  int status;
-  waitpid(pid, &status, 0);
+  B iBytes;
+  if (iLen==0) iBytes = emptyCVec();
+  else if (raw) {
+    CharBuf iBufRaw = get_chars(inObj);
+    iBytes = m_c8vec(iBufRaw.data, iLen);
+    free_chars(iBufRaw);
+  } else {
+    u8* ip; iBytes = m_c8arrv(&ip, iLen);
+    toUTF8(inObj, (char*)ip);
+  }
+  proc_write(p, iBytes, true); // writes while reading output, so neither side blocks
   
-  *s_outp = s_out;
-  *s_errp = s_err;
-  return WIFEXITED(status)?   WEXITSTATUS(status)
-       : WIFSIGNALED(status)? WTERMSIG(status)+128
-       : -1;
+  i32 code = proc_wait(p);
+  *s_outp = p->buf[0]; p->buf[0] = bi_N;
+  *s_errp = p->buf[1]; p->buf[1] = bi_N;
+  ptr_dec(p);
+  return code;
+}
+
+// •proc: process handles are namespaces with pid exported, and the ProcObj hidden
+STATIC_GLOBAL Body* proc_handleNs;
+static B proc_handle(ProcObj* p) {
+  if (proc_handleNs==NULL) {
+    proc_handleNs = m_nnsDesc("obj", "pid");
+    proc_handleNs->nsDesc->expGIDs[0] = -1;
+  }
+  return m_nns(proc_handleNs, tag(p,OBJ_TAG), m_f64(p->pid));
+}
+static ProcObj* proc_get(B h, char* name) { // doesn't consume
+  if (!isNsp(h) || proc_handleNs==NULL || c(NS,h)->desc != proc_handleNs->nsDesc) thrF("%U: Expected a process handle from •proc.Spawn", name);
+  return c(ProcObj, c(NS,h)->sc->vars[0]);
+}
+
+B pSpawn_c2(B t, B w, B x) {
+  u64 limit = U64_MAX;
+  if (!q_N(w)) {
+    if (!isNsp(w)) thrM("•proc.Spawn: 𝕨 must be a namespace");
+    B limitObj = ns_getC(w, "limit");
+    if (!q_N(limitObj)) {
+      f64 l = o2f(limitObj);
+      if (!(l>=1)) thrM("•proc.Spawn: limit must be at least 1");
+      if (l < (f64)U64_MAX) limit = (u64)l;
+    }
+  }
+  if (isAtm(x) || RNK(x)!=1) thrM("•proc.Spawn: 𝕩 must be a list of strings");
+  if (IA(x)==0) thrM("•proc.Spawn: 𝕩 must have at least one item");
+  ProcObj* p = proc_spawn("•proc.Spawn", x, limit);
+  dec(w); decG(x);
+  return proc_handle(p);
+}
+B pSpawn_c1(B t, B x) { return pSpawn_c2(t, bi_N, x); }
+
+B pWrite_c2(B t, B w, B x) {
+  ProcObj* p = proc_get(w, "•proc.Write");
+  if (isAtm(x) || RNK(x)!=1) thrM("•proc.Write: 𝕩 must be a list of bytes");
+  if (p->fd[0]<0) thrM("•proc.Write: Process input is closed");
+  CharBuf buf = get_chars(x);
+  B bytes = m_c8vec(buf.data, IA(x));
+  free_chars(buf);
+  decG(x);
+  proc_write(p, bytes, false);
+  return w;
+}
+B pClose_c1(B t, B x) {
+  proc_write(proc_get(x, "•proc.Close"), emptyCVec(), true);
+  return x;
+}
+B pReadChunk_c2(B t, B w, B x) {
+  ProcObj* p = proc_get(x, "•proc.ReadChunk");
+  i32 s = q_N(w)? 1 : o2i(w);
+  if (s!=1 && s!=2) thrM("•proc.ReadChunk: 𝕨 must be 1 (stdout) or 2 (stderr)");
+  while (IA(p->buf[s-1])==0 && p->fd[s]>=0) proc_poll(&p, 1, -1);
+  B r = toC8Any(p->buf[s-1]);
+  p->buf[s-1] = emptyCVec();
+  decG(x);
+  return r;
+}
+B pReadChunk_c1(B t, B x) { return pReadChunk_c2(t, bi_N, x); }
+B pWait_c1(B t, B x) {
+  i32 code = proc_wait(proc_get(x, "•proc.Wait"));
+  decG(x);
+  return m_i32(code);
+}
+B pWaitAny_c1(B t, B x) {
+  if (isAtm(x) || RNK(x)!=1) thrM("•proc.WaitAny: 𝕩 must be a list of process handles");
+  usz n = IA(x);
+  if (n==0) thrM("•proc.WaitAny: 𝕩 must have at least one item");
+  TALLOC(ProcObj*, ps, n);
+  SGetU(x)
+  for (usz i = 0; i < n; i++) ps[i] = proc_get(GetU(x,i), "•proc.WaitAny");
+  usz r;
+  while (true) {
+    for (r = 0; r < n; r++) if (ps[r]->reaped) goto done;
+    proc_poll(ps, n, -1);
+  }
+  done:
+  TFREE(ps);
+  decG(x);
+  return m_usz(r);
 }
 #elif defined(_WIN32) || defined(_WIN64)
 #define HAS_SH 1
@@ -1262,6 +1608,29 @@ static i32 sh_core(bool raw, B x, usz xia, B inObj, u64 iLen, B* s_outp, B* s_er
 #endif
 B sh_c1(B t, B x) { return sh_c2(t, bi_N, x); }
 
+#if !HAS_PROC
+  #define HAS_PROC 0
+  B pSpawn_c2   (B t, B w, B x) { thrM("•proc.Spawn: Not supported on this platform"); }
+  B pSpawn_c1   (B t,      B x) { thrM("•proc.Spawn: Not supported on this platform"); }
+  B pWrite_c2   (B t, B w, B x) { thrM("•proc.Write: Not supported on this platform"); }
+  B pClose_c1   (B t,      B x) { thrM("•proc.Close: Not supported on this platform"); }
+  B pReadChunk_c2(B t, B w, B x) { thrM("•proc.ReadChunk: Not supported on this platform"); }
+  B pReadChunk_c1(B t,     B x) { thrM("•proc.ReadChunk: Not supported on this platform"); }
+  B pWait_c1    (B t,      B x) { thrM("•proc.Wait: Not supported on this platform"); }
+  B pWaitAny_c1 (B t,      B x) { thrM("•proc.WaitAny: Not supported on this platform"); }
+#endif
+STATIC_GLOBAL B procNS;
+B getProcNS(void) {
+  if (procNS.u == 0) {
+    #define F(X) incG(bi_##X),
+    Body* d = m_nnsDesc("spawn", "write", "close", "readchunk", "wait", "waitany");
+    procNS =  m_nns(d,F(pSpawn)F(pWrite)F(pClose)F(pReadChunk)F(pWait)F(pWaitAny));
+    #undef F
+    gc_add(procNS);
+  }
+  return incG(procNS);
+}
+
 
 
 #if __has_include(<termios.h>)
@@ -1406,12 +1775,12 @@ B getNsNS(void) {
 
 
 
-typedef struct CastType { usz s; bool c; } CastType;
+typedef struct CastType { usz s; bool c; bool f; } CastType; // c: character type; f: 32-bit float, which has no array type, so its elements are converted to & from f64
 static bool isCharArr(B x) {
   return elChr(TI(x,elType));
 }
 static CastType getCastType(B e, bool hasVal, B val) { // returns a valid type (doesn't check if it can apply to val)
-  usz s; bool c;
+  usz s; bool c; bool f = false;
   if (isNum(e)) {
     s = o2s(e);
     if (s!=1 && s!=8 && s!=16 && s!=32 && s!=64) thrF("•bit._cast: unsupported width %s", s);
@@ -1425,11 +1794,11 @@ static CastType getCastType(B e, bool hasVal, B val) { // returns a valid type (
     if      (c     ) { if (s!=8 && s!=16 && s!=32) { badWidth: thrF("•bit._cast: unsupported width %s for type '%c'", s, (char)t); } }
     else if (t=='i') { if (s!=8 && s!=16 && s!=32) goto badWidth; }
     else if (t=='u') { if (s!=1) goto badWidth; }
-    else if (t=='f') { if (s!=64) goto badWidth; }
+    else if (t=='f') { if (s!=32 && s!=64) goto badWidth; f = s==32; }
     else thrM("•bit._cast: type descriptor in 𝕗 must be one of \"iufnc\"");
     
   }
-  return (CastType) { s, c };
+  return (CastType) { s, c, f };
   
 }
 static B convert(CastType t, B x) {
@@ -1459,6 +1828,18 @@ static u8 typeOfCast(CastType t) {
     case 64: return t_f64arr;
   }
 }
+static B f32_toBits(B x) { // consumes; i32arr of the elements of x rounded to 32-bit floats
+  B t = toF64Any(x); f64* tp = f64any_ptr(t);
+  i32* rp; B r = m_i32arrc(&rp, t);
+  vfor (usz i = 0; i < IA(t); i++) ((f32*)rp)[i] = tp[i];
+  decG(t); return r;
+}
+static B f32_fromBits(B x) { // consumes; f64arr of the 32-bit floats whose bits are the elements of the i32 array x
+  f32* xp = tyany_ptr(x);
+  f64* rp; B r = m_f64arrc(&rp, x);
+  vfor (usz i = 0; i < IA(x); i++) rp[i] = xp[i];
+  decG(x); return r;
+}
 static B set_bit_result(B r, u8 rt, ur rr, usz rl, usz *sh) {
   // Cast to output type
   v(r)->type = IS_SLICE(v(r)->type) ? TO_SLICE(rt) : rt;
@@ -1491,6 +1872,7 @@ B bitcast_impl(B el0, B el1, B x) {
   u64 s=xct.s*(u64)sh[xr-1], rl=s/rct.s;
   if (rl*rct.s != s) thrM("•bit._cast: incompatible lengths");
   if (rl>=USZ_MAX) thrM("•bit._cast: output too large");
+  if (xct.f) x = f32_toBits(x);
   B r = convert(xct, x);
   u8 rt = typeOfCast(rct);
   if (rt==t_bitarr && (v(r)->refc!=1 || IS_SLICE(TY(r)))) {
@@ -1506,7 +1888,8 @@ B bitcast_impl(B el0, B el1, B x) {
       }
     #endif
   }
-  return set_bit_result(r, rt, xr, rl, sh);
+  r = set_bit_result(r, rt, xr, rl, sh);
+  return rct.f? f32_fromBits(r) : r;
 }
 
 B bitcast_c1(Md1D* d, B x) { B f = d->f;
@@ -1727,12 +2110,14 @@ STATIC_GLOBAL Body* file_nsGen;
   F("getline", U"•GetLine", bi_getLine) \
   F("type", U"•Type", bi_type) \
   OPTSYS(HAS_SH)(F("sh", U"•SH", bi_sh)) \
+  OPTSYS(HAS_PROC)(F("proc", U"•proc", tag(23,VAR_TAG))) \
   F("decompose", U"•Decompose", bi_decp) \
   F("while", U"•_while_", bi_while) \
   F("cmp", U"•Cmp", bi_cmp) \
   F("unixtime", U"•UnixTime", bi_unixTime) \
   F("monotime", U"•MonoTime", bi_monoTime) \
   F("timed", U"•_timed", bi_timed) \
+  F("timedperf", U"•_timedPerf", bi_timedPerf) \
   F("delay", U"•Delay", bi_delay) \
   F("hash", U"•Hash", bi_hash) \
   F("repr", U"•Repr", bi_repr) \
@@ -1941,6 +2326,7 @@ B sys_c1(B t, B x) {
       case 20: cr = getPlatformNS(); break; // •platform
       case 21: cr = incG(CACHE_OBJ(bqn,   m_nfn(bqnDesc,   incG(COMPS_CREF(re))))); break; // •BQN
       case 22: cr = incG(CACHE_OBJ(rebqn, m_nfn(rebqnDesc, incG(COMPS_CREF(re))))); break; // •ReBQN
+      case 23: cr = getProcNS(); break; // •proc
     }
     HARR_ADD(r, i, cr);
   }
@@ -1971,13 +2357,14 @@ u32* const dsv_text[] = {
   U"•file.Accessed",U"•file.At",U"•file.Bytes",U"•file.Chars",U"•file.Created",U"•file.CreateDir",U"•file.Exists",U"•file.Lines",U"•file.List",
   U"•file.MapBytes",U"•file.Modified",U"•file.Name",U"•file.Parent",U"•file.path",U"•file.RealPath",U"•file.Remove",U"•file.Rename",U"•file.Size",U"•file.Type",
   
-  U"•internal.ClearRefs",U"•internal.DeepSqueeze",U"•internal.EEqual",U"•internal.ElType",U"•internal.GC",U"•internal.HasFill",U"•internal.HeapDump",U"•internal.HeapStats",U"•internal.Info",U"•internal.IsPure",U"•internal.Keep",U"•internal.ListVariations",U"•internal.ObjFlags",U"•internal.PureKeep",U"•internal.Refc",U"•internal.Squeeze",U"•internal.Temp",U"•internal.Type",U"•internal.Unshare",U"•internal.Variation",
+  U"•internal.AllocSites",U"•internal.ClearRefs",U"•internal.DeepSqueeze",U"•internal.EEqual",U"•internal.ElType",U"•internal.GC",U"•internal.HasFill",U"•internal.HeapDump",U"•internal.HeapStats",U"•internal.Info",U"•internal.IsPure",U"•internal.Keep",U"•internal.ListVariations",U"•internal.ObjFlags",U"•internal.PureKeep",U"•internal.Refc",U"•internal.Squeeze",U"•internal.Temp",U"•internal.Type",U"•internal.Unshare",U"•internal.Variation",
   U"•math.Acos",U"•math.Acosh",U"•math.Asin",U"•math.Asinh",U"•math.Atan",U"•math.Atan2",U"•math.Atanh",U"•math.Cbrt",U"•math.Comb",U"•math.Cos",U"•math.Cosh",U"•math.Erf",U"•math.ErfC",U"•math.Expm1",U"•math.Fact",U"•math.GCD",U"•math.Hypot",U"•math.LCM",U"•math.Log10",U"•math.Log1p",U"•math.Log2",U"•math.LogFact",U"•math.Sin",U"•math.Sinh",U"•math.Sum",U"•math.Tan",U"•math.Tanh",
   
   U"•ns.Get",U"•ns.Has",U"•ns.Keys",
   U"•platform.bqn.impl",U"•platform.bqn.implVersion",U"•platform.cpu.arch",U"•platform.environment",U"•platform.os",
+  U"•proc.Close",U"•proc.ReadChunk",U"•proc.Spawn",U"•proc.Wait",U"•proc.WaitAny",U"•proc.Write",
   
-  U"•rand.Deal",U"•rand.Range",U"•rand.Subset",
+  U"•rand.Deal",U"•rand.Exponential",U"•rand.Normal",U"•rand.Range",U"•rand.Shuffle",U"•rand.Subset",
   U"•term.CharB",U"•term.CharN",U"•term.ErrRaw",U"•term.Flush",U"•term.OutRaw",U"•term.RawMode",
   NULL
 };
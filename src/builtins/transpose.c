@@ -2,7 +2,7 @@
 
 // Transpose
 // One length-2 axis: dedicated code
-//   Boolean: pdep or emulation for height 2; pext for width 2
+//   Boolean: pdep or emulation for height 2; pext for width 2; BMI2 is detected at runtime
 //     SHOULD use a generic implementation if BMI2 not present
 // SHOULD optimize other short lengths with pdep/pext and shuffles
 // Boolean 𝕩: convert to integer
@@ -40,13 +40,13 @@
 #include "../builtins.h"
 #include "../utils/calls.h"
 
-#ifdef __BMI2__
-  #if !SLOW_PDEP
-    #define FAST_PDEP 1
-  #endif
+#include "../utils/cpu.h"
+
+#if CPU_DETECT
   #include <immintrin.h>
   #if USE_VALGRIND
     #define _pdep_u64 vg_pdep_u64
+    #define _pext_u64 vg_pext_u64
   #endif
 #endif
 
@@ -71,12 +71,25 @@ typedef void (*TranspFn)(void*,void*,u64,u64,u64,u64);
 #endif
 
 
+#if CPU_DETECT
+static TARGET_BMI2 void interleave_bits_pdep(u64* rp, u32* x0, u32* x1, usz n) {
+  for (usz i=0; i<BIT_N(n); i++) rp[i] = _pdep_u64(x0[i], 0x5555555555555555) | _pdep_u64(x1[i], 0xAAAAAAAAAAAAAAAA);
+}
+static TARGET_BMI2 void deinterleave_bits_pext(u32* r0, u32* r1, u64* xp, usz n) {
+  for (usz i=0; i<BIT_N(n); i++) {
+    u64 v = xp[i];
+    r0[i] = _pext_u64(v, 0x5555555555555555);
+    r1[i] = _pext_u64(v, 0xAAAAAAAAAAAAAAAA);
+  }
+}
+#endif
+
 static void interleave_bits(u64* rp, void* x0v, void* x1v, usz n) {
   u32* x0 = (u32*)x0v; u32* x1 = (u32*)x1v;
+  #if CPU_DETECT
+    if (HAS_FAST_PDEP) { interleave_bits_pdep(rp, x0, x1, n); return; }
+  #endif
   for (usz i=0; i<BIT_N(n); i++) {
-    #if FAST_PDEP
-    rp[i] = _pdep_u64(x0[i], 0x5555555555555555) | _pdep_u64(x1[i], 0xAAAAAAAAAAAAAAAA);
-    #else
     #define STEP(V,M,SH) V = (V | V<<SH) & M;
     #define EXPAND(V) \
       STEP(V, 0x0000ffff0000ffff, 16) \
@@ -89,7 +102,6 @@ static void interleave_bits(u64* rp, void* x0v, void* x1v, usz n) {
     rp[i] = e0 | e1<<1;
     #undef EXPAND
     #undef STEP
-    #endif
   }
 }
 
@@ -198,16 +210,12 @@ static Arr* transpose_noshape(B* px, usz ia, usz w, usz h) {
       Arr* x1o = TI(x,slice)(incG(x),w,w);
       interleave_bits(rp, bitany_ptr(x), bitanyv_ptr(x1o), ia);
       mm_free((Value*)x1o);
-    #ifdef __BMI2__
-    } else if (w==2) {
+    #if CPU_DETECT
+    } else if (w==2 && HAS_BMI2) {
       u64* xp = bitany_ptr(x);
       u64* r0; r=m_bitarrp(&r0, ia);
       TALLOC(u64, r1, BIT_N(h));
-      for (usz i=0; i<BIT_N(ia); i++) {
-        u64 v = xp[i];
-        ((u32*)r0)[i] = _pext_u64(v, 0x5555555555555555);
-        ((u32*)r1)[i] = _pext_u64(v, 0xAAAAAAAAAAAAAAAA);
-      }
+      deinterleave_bits_pext((u32*)r0, (u32*)r1, xp, ia);
       bit_cpyN(r0, h, r1, 0, h);
       TFREE(r1);
     #endif
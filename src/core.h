@@ -20,6 +20,7 @@
 
 #include "core/numarr.h"
 #include "core/chrarr.h"
+#include "core/strlist.h"
 #include "core/fillarr.h"
 
 #include "core/derv.h"
@@ -62,6 +62,14 @@ SHOULD_INLINE void* m_tyarrlbp(Arr** rp, usz w, usz ia, u8 type) M_TYARR(2, , ,
 SHOULD_INLINE void* m_tyarrlbv(B*    rp, usz w, usz ia, u8 type) M_TYARR(2, , arr_shVec((Arr*)r);, taga(r), )
 SHOULD_INLINE void* m_tyarrlbc(B*    rp, usz w, B x,    u8 type) M_TYARR(2, , arr_shCopy((Arr*)r,x);, taga(r), usz ia = IA(x);)
 
+// m_tyarrlbc, but returns x or y (tried in that order; y must have the same shape as x, and both must be arrays) if it's unshared and already of the result type
+// the result may alias the argument data, so the operation must read element i of all inputs before writing result element i, and must not restart after writing; the reused argument gets an extra reference
+SHOULD_INLINE void* m_tyarrlbcR(B* rp, usz w, B x, B y, u8 type) {
+  if (reusable(x) && TY(x)==type) { *rp = incG(REUSE(x)); return tyarr_ptr(x); }
+  if (reusable(y) && TY(y)==type) { *rp = incG(REUSE(y)); return tyarr_ptr(y); }
+  return m_tyarrlbc(rp, w, x, type);
+}
+
 extern u8 const elType2type[];
 #define el2t(X) elType2type[X] // TODO maybe reorganize array types such that this can just be addition?
 extern u8 const elTypeWidth[];
@@ -81,6 +89,7 @@ SHOULD_INLINE void arr_check_size(u64 sz, u8 type, u64 ia) {
     assert(IS_ANY_ARR(type) || type==t_harrPartial);
     if (!IS_SLICE(type)) {
       if (type==t_harr || type==t_harrPartial) assert(sz >= fsizeof(HArr,a,B,ia));
+      else if (type==t_strlist) assert(sz >= fsizeof(StrList,off,usz,ia+(u64)1));
       else assert(sz >= offsetof(TyArr,a) + (((ia<<arrTypeBitsLog(type))+7)>>3));
     }
   #endif
@@ -21,8 +21,6 @@ B md1D_c1(B t,      B x) { Md1D* tc = c(Md1D, t); return ((Md1*)tc->m1)->c1(tc,
 B md1D_c2(B t, B w, B x) { Md1D* tc = c(Md1D, t); return ((Md1*)tc->m1)->c2(tc, w, x); }
 B md2D_c1(B t,      B x) { Md2D* tc = c(Md2D, t); return ((Md2*)tc->m2)->c1(tc,    x); }
 B md2D_c2(B t, B w, B x) { Md2D* tc = c(Md2D, t); return ((Md2*)tc->m2)->c2(tc, w, x); }
-B tr2D_c1(B t,      B x) { return c1(c(Atop,t)->g, c1(c(Atop,t)->h,    x)); }
-B tr2D_c2(B t, B w, B x) { return c1(c(Atop,t)->g, c2(c(Atop,t)->h, w, x)); }
 
 B fork_c1_general(B t, B x) {
   B hr = c1(c(Fork,t)->h, inc(x));
@@ -42,16 +40,174 @@ B fork_c1_nff(B t, B x) {
   B hr = c1G(c(Fork,t)->h, x);
   return c2G(c(Fork,t)->g, c(Fork,t)->f, hr);
 }
-B fork_c1(B t, B x) {
-  FC1 fn;
-  B g = c(Fork,t)->g; if (!isFun(g)) { fn=fork_c1_general; goto go; }
-  B h = c(Fork,t)->h; if (!isFun(h)) { fn=fork_c1_general; goto go; }
-  B f = c(Fork,t)->f;
-  if (isFun(f)) { fn=fork_c1_fff; goto go; }
-  if (isVal(f)) { fn=fork_c1_vff; goto go; }
-  else          { fn=fork_c1_nff; goto go; }
+#if FUSE_TRAINS
+// Fused evaluation of trains whose every function is a pervasive arithmetic/comparison builtin, ⊢, ⊣, or a nested such train, with number constants as fork left tines.
+// The train is compiled into a list of builtin calls, which is then run on FUSE_CHUNK-element blocks of the arguments, so intermediate results stay in cache and only the final result is allocated in full.
+// A block can't always reproduce what the whole-array call does (e.g. one overflowing block makes the unfused + produce f64 for all elements, affecting later steps), so the
+// element class (integer or f64) of every step is required to be the same in all blocks; if not, the fused attempt is dropped and the train is evaluated normally.
+#define FUSE_CHUNK 1024  // must be a multiple of 64 for bitarr output
+#define FUSE_MIN (1<<14) // minimum argument size to attempt fusion on
+#define FUSE_MAX 16      // maximum number of builtin calls in a fused train
+#define FUSE_MINOPS 3    // with fewer calls, reusing unshared intermediate results in place is as good
+
+typedef struct FuseOp { B f; u8 w, x, r; } FuseOp; // slots; w==FUSE_NONE for a monadic call
+typedef struct FuseProg {
+  u8 opAm, slotAm;
+  FuseOp ops[FUSE_MAX];
+  B consts[FUSE_MAX*2]; // constant value of each slot, or bi_N if it's an argument or a result
+} FuseProg;
+enum { FUSE_W=0, FUSE_X=1, FUSE_NONE=255 };
+
+static bool fuse_isBI(B f, u8 rtid) { return TY(f)==t_funBI && (u8)(v(f)->flags-1)==rtid; }
+static u8 fuse_op(FuseProg* p, B f, u8 w, u8 x) {
+  if (w==FUSE_NONE? !isPervasiveMon(f) : !isPervasiveDy(f)) return FUSE_NONE;
+  if (p->opAm==FUSE_MAX) return FUSE_NONE;
+  u8 r = p->slotAm++;
+  p->consts[r] = bi_N;
+  p->ops[p->opAm++] = (FuseOp){.f=f, .w=w, .x=x, .r=r};
+  return r;
+}
+static u8 fuse_compile(FuseProg* p, B f, bool dy) { // returns the slot holding the result of calling f, or FUSE_NONE if f can't be fused
+  if (!isFun(f)) return FUSE_NONE;
+  switch (TY(f)) { default: return FUSE_NONE;
+    case t_funBI:
+      if (fuse_isBI(f, n_rtack)) return FUSE_X;
+      if (fuse_isBI(f, n_ltack)) return dy? FUSE_W : FUSE_X;
+      return fuse_op(p, f, dy? FUSE_W : FUSE_NONE, FUSE_X);
+    case t_atop: {
+      u8 h = fuse_compile(p, c(Atop,f)->h, dy); if (h==FUSE_NONE) return FUSE_NONE;
+      return fuse_op(p, c(Atop,f)->g, FUSE_NONE, h);
+    }
+    case t_fork: {
+      B g = c(Fork,f)->g; if (!isFun(g)) return FUSE_NONE;
+      B l = c(Fork,f)->f; u8 lr;
+      if (isNum(l)) { lr = p->slotAm++; p->consts[lr] = l; }
+      else if ((lr = fuse_compile(p, l, dy)) == FUSE_NONE) return FUSE_NONE;
+      u8 h = fuse_compile(p, c(Fork,f)->h, dy); if (h==FUSE_NONE) return FUSE_NONE;
+      return fuse_op(p, g, lr, h);
+    }
+  }
+}
+static bool fuse_init(FuseProg* p, B t, bool dy) {
+  p->opAm = 0;
+  p->slotAm = 2;
+  p->consts[FUSE_W] = p->consts[FUSE_X] = bi_N;
+  u8 r = fuse_compile(p, t, dy);
+  return r!=FUSE_NONE && p->opAm>=FUSE_MINOPS && r==p->ops[p->opAm-1].r;
+}
+
+static bool fuse_argOk(B x) { return isArr(x)? TI(x,elType)<=el_f64 : isNum(x); }
+static u8 fuse_class(B x) { // 0: integer array; 1: f64 array; 2: number atom; 3: anything else
+  if (isArr(x)) { u8 xe = TI(x,elType); return xe<=el_i32? 0 : xe==el_f64? 1 : 3; }
+  return isNum(x)? 2 : 3;
+}
+static void* fuse_alloc(B* r, u8 e, B sh) {
+  return e==el_bit? m_tyarrlbc(r, 0, sh, t_bitarr) : m_tyarrc(r, elWidth(e), sh, el2t(e));
+}
+
+// consumes w & x on success; returns bi_N without consuming them if the arguments aren't suitable or fusion had to be abandoned
+static B fuse_run(B t, B w, B x, bool dy) {
+  B sh = isArr(x)? x : w;
+  if (!isArr(sh) || IA(sh)<FUSE_MIN || !fuse_argOk(x) || (dy && !fuse_argOk(w))) return bi_N;
+  if (dy && isArr(w) && isArr(x) && !eqShape(w, x)) return bi_N;
+  FuseProg p;
+  if (!fuse_init(&p, t, dy)) return bi_N;
   
-  go:
+  usz ia = IA(sh);
+  B v[FUSE_MAX*2];
+  bool live[FUSE_MAX*2]; // whether a result slot holds a not yet consumed value
+  u8 cls[FUSE_MAX];
+  B r = bi_N; void* rp = NULL; u8 re = el_MAX;
+  for (usz s = 0; s < ia; s+= FUSE_CHUNK) {
+    usz l = ia-s<FUSE_CHUNK? ia-s : FUSE_CHUNK;
+    v[FUSE_W] = dy && isArr(w)? taga(arr_shVec(TI(w,slice)(incG(w), s, l))) : w;
+    v[FUSE_X] =       isArr(x)? taga(arr_shVec(TI(x,slice)(incG(x), s, l))) : x;
+    for (u8 i = 2; i < p.slotAm; i++) { v[i] = p.consts[i]; live[i] = false; }
+    
+    for (u8 i = 0; i < p.opAm; i++) { // every result slot is used exactly once, so results are passed on without incrementing
+      FuseOp o = p.ops[i];
+      B ox = o.x<2? inc(v[o.x]) : v[o.x];                     live[o.x] = false;
+      B ow = o.w==FUSE_NONE? bi_N : o.w<2? inc(v[o.w]) : v[o.w]; if (o.w!=FUSE_NONE) live[o.w] = false;
+      B c = o.w==FUSE_NONE? c1(o.f, ox) : c2(o.f, ow, ox);
+      u8 cc = fuse_class(c);
+      if (s==0) cls[i] = cc;
+      v[o.r] = c; live[o.r] = true;
+      if (cls[i]!=cc || cc==3) {
+        for (u8 j = 2; j < p.slotAm; j++) if (live[j]) dec(v[j]);
+        goto abandon;
+      }
+    }
+    
+    B c = v[p.ops[p.opAm-1].r];
+    if (!isArr(c)) { dec(c); goto abandon; }
+    u8 ce = TI(c,elType);
+    if (re==el_MAX || ce>re) { // allocate the result, or widen it to fit a wider integer type
+      B r2; void* rp2 = fuse_alloc(&r2, ce, sh);
+      if (re!=el_MAX) { COPY_TO(rp2, ce, 0, r, 0, s); decG(r); }
+      r = r2; rp = rp2; re = ce;
+    }
+    COPY_TO(rp, re, s, c, 0, l);
+    decG(c);
+    if (dy && isArr(w)) decG(v[FUSE_W]);
+    if (isArr(x)) decG(v[FUSE_X]);
+  }
+  dec(w); dec(x);
+  return r;
+  
+  abandon:
+  if (dy && isArr(w)) decG(v[FUSE_W]);
+  if (isArr(x)) decG(v[FUSE_X]);
+  if (re!=el_MAX) decG(r);
+  return bi_N;
+}
+#endif
+
+B tr2D_c1(B t,      B x) { return c1(c(Atop,t)->g, c1(c(Atop,t)->h,    x)); }
+B tr2D_c2(B t, B w, B x) { return c1(c(Atop,t)->g, c2(c(Atop,t)->h, w, x)); }
+#if FUSE_TRAINS
+B tr2D_c1_fused(B t, B x) {
+  B r = fuse_run(t, bi_N, x, false);
+  if (!q_N(r)) return r;
+  return tr2D_c1(t, x);
+}
+B tr2D_c2_fused(B t, B w, B x) {
+  B r = fuse_run(t, w, x, true);
+  if (!q_N(r)) return r;
+  return tr2D_c2(t, w, x);
+}
+B tr2D_c1_init(B t, B x) {
+  FuseProg p;
+  c(Fun,t)->c1 = fuse_init(&p, t, false)? tr2D_c1_fused : tr2D_c1;
+  return c(Fun,t)->c1(t, x);
+}
+B tr2D_c2_init(B t, B w, B x) {
+  FuseProg p;
+  c(Fun,t)->c2 = fuse_init(&p, t, true)? tr2D_c2_fused : tr2D_c2;
+  return c(Fun,t)->c2(t, w, x);
+}
+#endif
+
+static FC1 fork_c1_unfused(B t) {
+  B g = c(Fork,t)->g; if (!isFun(g)) return fork_c1_general;
+  B h = c(Fork,t)->h; if (!isFun(h)) return fork_c1_general;
+  B f = c(Fork,t)->f;
+  if (isFun(f)) return fork_c1_fff;
+  if (isVal(f)) return fork_c1_vff;
+  else          return fork_c1_nff;
+}
+#if FUSE_TRAINS
+B fork_c1_fused(B t, B x) {
+  B r = fuse_run(t, bi_N, x, false);
+  if (!q_N(r)) return r;
+  return fork_c1_unfused(t)(t, x);
+}
+#endif
+B fork_c1(B t, B x) {
+  FC1 fn = fork_c1_unfused(t);
+  #if FUSE_TRAINS
+    FuseProg p;
+    if (fuse_init(&p, t, false)) fn = fork_c1_fused;
+  #endif
   c(Fun,t)->c1=fn;
   return c(Fun,t)->c1(t, x);
 }
@@ -74,16 +230,27 @@ B fork_c2_nff(B t, B w, B x) {
   B hr = c2G(c(Fork,t)->h, w, x);
   return c2G(c(Fork,t)->g, c(Fork,t)->f, hr);
 }
-B fork_c2(B t, B w, B x) {
-  FC2 fn;
-  B g = c(Fork,t)->g; if (!isFun(g)) { fn=fork_c2_general; goto go; }
-  B h = c(Fork,t)->h; if (!isFun(h)) { fn=fork_c2_general; goto go; }
+static FC2 fork_c2_unfused(B t) {
+  B g = c(Fork,t)->g; if (!isFun(g)) return fork_c2_general;
+  B h = c(Fork,t)->h; if (!isFun(h)) return fork_c2_general;
   B f = c(Fork,t)->f;
-  if (isFun(f)) { fn=fork_c2_fff; goto go; }
-  if (isVal(f)) { fn=fork_c2_vff; goto go; }
-  else          { fn=fork_c2_nff; goto go; }
-  
-  go:
+  if (isFun(f)) return fork_c2_fff;
+  if (isVal(f)) return fork_c2_vff;
+  else          return fork_c2_nff;
+}
+#if FUSE_TRAINS
+B fork_c2_fused(B t, B w, B x) {
+  B r = fuse_run(t, w, x, true);
+  if (!q_N(r)) return r;
+  return fork_c2_unfused(t)(t, w, x);
+}
+#endif
+B fork_c2(B t, B w, B x) {
+  FC2 fn = fork_c2_unfused(t);
+  #if FUSE_TRAINS
+    FuseProg p;
+    if (fuse_init(&p, t, true)) fn = fork_c2_fused;
+  #endif
   c(Fun,t)->c2=fn;
   return c(Fun,t)->c2(t, w, x);
 }
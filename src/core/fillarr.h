@@ -36,6 +36,7 @@ static B getFillN(B x) { // doesn't consume, doesn't increment result; can retur
         u8 t = TY(x);
         if (t==t_fillarr  ) return c(FillArr,  x)->fill;
         if (t==t_fillslice) return c(FillSlice,x)->fill;
+        if (t==t_strlist  ) return c(StrList,x)->fill? bi_emptyCVec : bi_noFill;
         return bi_noFill;
     }
   }
@@ -52,6 +53,7 @@ static B getFillR(B x) { // doesn't consume; can return bi_noFill
         u8 t = TY(x);
         if (t==t_fillarr  ) return inc(c(FillArr,  x)->fill);
         if (t==t_fillslice) return inc(c(FillSlice,x)->fill);
+        if (t==t_strlist  ) return c(StrList,x)->fill? emptyCVec() : bi_noFill;
         return bi_noFill;
     }
   }
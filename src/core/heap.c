@@ -111,3 +111,165 @@ void heap_printInfoStr(char* str) {
   }
   heap_printInfo(sizes, types, freed!=0, freed>=2);
 }
+
+#if HEAP_IMAGE
+#if !defined(__linux__) || NO_MMAP || MM==0
+  #error "HEAP_IMAGE requires Linux, mmap, and MM=1 or MM=2"
+#endif
+// A heap image is the state after cbqn_init: every GLOBAL (all of which are in the cbqn_state section), and every arena of
+// every allocator. Objects and JIT code refer to each other and to the binary with absolute addresses, so nothing is
+// relocated; instead the arenas are mapped back at their original addresses, and the image is only used if the binary is
+// the same file loaded at the same address (i.e. non-PIE, or ASLR disabled). Anything else falls back to regular init.
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../vm.h"
+
+extern char __start_cbqn_state[], __stop_cbqn_state[];
+#if MM==1
+  #define FOR_IMAGE_ALLOC(F) F(mm,0) F(mmX,1)
+#else
+  #define FOR_IMAGE_ALLOC(F) F(b1,0) F(b3,0) F(mmX,1)
+#endif
+#define F(N,X) u64 N##_imageArenas(HeapArena* r); void N##_imageRestore(HeapArena* a, u64 n);
+FOR_IMAGE_ALLOC(F)
+#undef F
+enum {
+  #define F(N,X) img_##N,
+  FOR_IMAGE_ALLOC(F)
+  #undef F
+  IMAGE_ALLOCS
+};
+static const bool image_exec[] = {
+  #define F(N,X) X,
+  FOR_IMAGE_ALLOC(F)
+  #undef F
+};
+void vm_imageRestore(void);
+
+#define IMAGE_MAGIC "CBQNimg1"
+typedef struct ImageHeader {
+  char magic[8];
+  u64 exeSize, exeIno, exeMtimeS, exeMtimeNs; // the binary the image was written by
+  u64 codeAt, stateAt, stateSz;
+  u64 arenaAm[IMAGE_ALLOCS];
+} ImageHeader;
+
+static bool image_header(ImageHeader* h) { // fills in everything other than arenaAm; false if the binary can't be identified
+  struct stat s;
+  if (stat("/proc/self/exe", &s) != 0) return false;
+  *h = (ImageHeader){
+    .exeSize = s.st_size, .exeIno = s.st_ino, .exeMtimeS = s.st_mtim.tv_sec, .exeMtimeNs = s.st_mtim.tv_nsec,
+    .codeAt = ptr2u64(&cbqn_init), .stateAt = ptr2u64(__start_cbqn_state), .stateSz = __stop_cbqn_state - __start_cbqn_state,
+  };
+  memcpy(h->magic, IMAGE_MAGIC, 8);
+  return true;
+}
+static u64 image_dataStart(u64 arenaAm) { // file offset of the first arena's contents
+  u64 ps = getPageSize();
+  u64 o = sizeof(ImageHeader) + arenaAm*sizeof(HeapArena) + (__stop_cbqn_state - __start_cbqn_state);
+  return (o + ps-1) / ps * ps;
+}
+
+static char* image_path(bool* explicit) { // CBQN_IMAGE if set (empty disables images), else the binary's path with .img appended; result must be freed
+  char* e = getenv("CBQN_IMAGE");
+  *explicit = e!=NULL;
+  if (e!=NULL) return *e? strdup(e) : NULL;
+  char buf[4096];
+  ssize_t l = readlink("/proc/self/exe", buf, sizeof(buf)-5);
+  if (l<=0) return NULL;
+  memcpy(buf+l, ".img", 5);
+  return strdup(buf);
+}
+
+bool heapImage_load() {
+  bool explicit;
+  char* path = image_path(&explicit);
+  if (path==NULL) return false;
+  int fd = open(path, O_RDONLY);
+  if (fd<0) goto failP;
+  
+  ImageHeader h, c;
+  HeapArena* as = NULL;
+  u64 mapped = 0;
+  if (pread(fd, &h, sizeof(h), 0) != sizeof(h) || !image_header(&c)) goto fail;
+  memcpy(c.arenaAm, h.arenaAm, sizeof(h.arenaAm));
+  if (memcmp(&h, &c, sizeof(h)) != 0) goto fail; // written by a different binary, or the binary or state moved
+  
+  u64 an = 0;
+  for (i32 i = 0; i < IMAGE_ALLOCS; i++) an+= h.arenaAm[i];
+  as = malloc(sizeof(HeapArena)*(an? an : 1));
+  u64 asz = sizeof(HeapArena)*an;
+  if (pread(fd, as, asz, sizeof(h)) != (ssize_t)asz) goto fail;
+  
+  u64 off = image_dataStart(an);
+  i32 ai = 0;
+  for (i32 i = 0; i < IMAGE_ALLOCS; i++) {
+    i32 prot = PROT_READ|PROT_WRITE|(image_exec[i]? PROT_EXEC : 0);
+    for (u64 j = 0; j < h.arenaAm[i]; j++, ai++) {
+      HeapArena a = as[ai];
+      void* m = mmap(a.mapP, a.mapSz, prot, MAP_PRIVATE|MAP_FIXED_NOREPLACE, fd, off);
+      if (m==MAP_FAILED) goto fail;
+      if (m!=a.mapP) { munmap(m, a.mapSz); goto fail; } // pre-4.17 kernels treat MAP_FIXED_NOREPLACE as a hint
+      mapped++;
+      off+= a.mapSz;
+    }
+  }
+  
+  u64 heapMax = mm_heapMax; // may have been set by the command line
+  if (pread(fd, __start_cbqn_state, h.stateSz, sizeof(h)+asz) != (ssize_t)h.stateSz) fatal("Failed to read heap image state");
+  mm_heapMax = heapMax;
+  close(fd);
+  
+  HeapArena* ac = as;
+  #define F(N,X) N##_imageRestore(ac, h.arenaAm[img_##N]); ac+= h.arenaAm[img_##N];
+  FOR_IMAGE_ALLOC(F)
+  #undef F
+  vm_imageRestore();
+  free(as);
+  free(path);
+  return true;
+  
+  fail:
+  for (u64 i = 0; i < mapped; i++) munmap(as[i].mapP, as[i].mapSz);
+  free(as);
+  close(fd);
+  failP:
+  if (explicit) fprintf(stderr, "Warning: heap image \"%s\" not used; it may be missing or stale, or this is a PIE build with ASLR enabled\n", path);
+  free(path);
+  return false;
+}
+
+void heapImage_write(char* path) {
+  gc_forceGC(true);
+  ImageHeader h;
+  if (!image_header(&h)) { fprintf(stderr, "Failed to write heap image - could not identify the binary\n"); exit(1); }
+  u64 an = 0;
+  #define F(N,X) an+= h.arenaAm[img_##N] = N##_imageArenas(NULL);
+  FOR_IMAGE_ALLOC(F)
+  #undef F
+  HeapArena* as = malloc(sizeof(HeapArena)*(an? an : 1));
+  HeapArena* ac = as;
+  #define F(N,X) ac+= N##_imageArenas(ac);
+  FOR_IMAGE_ALLOC(F)
+  #undef F
+  
+  usz pl = strlen(path);
+  char* tmp = malloc(pl+5);
+  memcpy(tmp, path, pl); memcpy(tmp+pl, ".tmp", 5);
+  FILE* f = fopen(tmp, "wb");
+  if (f==NULL) { fprintf(stderr, "Failed to write heap image - could not open \"%s\" for writing\n", tmp); exit(1); }
+  fwrite(&h, sizeof(h), 1, f);
+  fwrite(as, sizeof(HeapArena), an, f);
+  fwrite(__start_cbqn_state, 1, h.stateSz, f);
+  for (u64 i = ftell(f), e = image_dataStart(an); i < e; i++) fputc(0, f);
+  for (u64 i = 0; i < an; i++) fwrite(as[i].mapP, 1, as[i].mapSz, f);
+  bool ok = !ferror(f);
+  ok&= fclose(f)==0;
+  if (!ok || rename(tmp, path)!=0) { fprintf(stderr, "Failed to write heap image: %s\n", strerror(errno)); remove(tmp); exit(1); }
+  free(tmp);
+  free(as);
+}
+#endif
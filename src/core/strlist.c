@@ -0,0 +1,330 @@
+// Packed lists of strings, produced by •file.Lines, 𝕨⊔𝕩 with sorted 𝕨 and a character list 𝕩, and •internal.Variation "Asl"
+
+// A list of n strings is one character array holding all of them plus
+// n+1 offsets, instead of n separately allocated arrays. Primitives that
+// can work on the characters & offsets check for a strlist themselves:
+//   ≠¨ (md1.c) is the offset differences; ∾ (sfns.c) is a slice of the characters
+//   ≡ (depthF) is 2, or 1 if empty
+//   ⍷ ⊐ ∊ (selfsearch.c), and 𝕨⊐𝕩 𝕨∊𝕩 (search.c) with a strlist on one side
+//     and strings on the other, use an open-addressing hash table of string indices
+//   ∧ ∨ ⍋ ⍒ (grade.h) read the strings in place for the multikey quicksort
+//   𝕨⊏𝕩 (select.c) with an integer list 𝕨, and the results of ⍷ ∧ ∨, copy
+//     the selected strings into a new strlist
+// •file.Lines with a strlist 𝕩 writes the characters out directly.
+// ⊑ and 𝕨⊑𝕩 copy the string. Everything else reads elements like for any
+// other array, and as getU can't return a new object, the first get or
+// getU instead turns the strlist in place into an hslice (or fillslice)
+// of a regular array of the strings, dropping the packed characters; from
+// then on it's an ordinary array, and only one copy of the strings exists.
+// get & getU may be called where allocating isn't otherwise allowed, so
+// that's done with GC off, turning it back on if building the array throws.
+
+#include "../core.h"
+#include "../builtins.h"
+#include "../utils/hash.h"
+#include "../utils/talloc.h"
+
+StrList* m_strlistp(B chars, bool fill, usz ia) {
+  u64 sz = fsizeof(StrList, off, usz, ia+(u64)1);
+  if (sz < sizeof(FillSlice)) sz = sizeof(FillSlice); // room for strlist_unpack
+  StrList* r = m_arr(sz, t_strlist, ia);
+  arr_shVec((Arr*)r);
+  r->chars = chars;
+  r->fill = fill;
+  return r;
+}
+
+static u8 chrArrType(u8 el) { return el==el_c8? t_c8arr : el==el_c16? t_c16arr : t_c32arr; }
+static B strlist_copy(StrList* x, usz i) { // new copy of string i
+  B c = x->chars;
+  u8 el = TI(c,elType);
+  usz s = x->off[i], l = x->off[i+1]-s;
+  B r; void* rp = m_tyarrv(&r, elWidth(el), l, chrArrType(el));
+  if (l) COPY_TO(rp, el, 0, c, s, l);
+  return r;
+}
+B strlist_str(B x, usz i) { return strlist_copy(c(StrList,x), i); }
+
+static NOINLINE void strlist_unpack(StrList* x) {
+  #if DEBUG
+    bool noAlloc = cbqn_noAlloc; cbqn_noAlloc = false;
+  #endif
+  gc_disable();
+  if (CATCH) { // e.g. an OOM; don't leave GC off for the rest of the process
+    gc_enable();
+    #if DEBUG
+      cbqn_noAlloc = noAlloc;
+    #endif
+    rethrow();
+  }
+  usz ia = PIA(x);
+  M_HARR(r, ia)
+  for (usz i = 0; i < ia; i++) HARR_ADD(r, i, strlist_copy(x, i));
+  HArr* p = c(HArr, HARR_FV(r));
+  popCatch();
+  B chars = x->chars; // overlaps the slice fields
+  if (x->fill) {
+    FillSlice* s = (FillSlice*)x;
+    s->p = (Arr*)p; s->a = p->a; s->fill = emptyCVec();
+    s->type = t_fillslice;
+  } else {
+    HSlice* s = (HSlice*)x;
+    s->p = (Arr*)p; s->a = p->a;
+    s->type = t_hslice;
+  }
+  dec(chars);
+  gc_enable();
+  #if DEBUG
+    cbqn_noAlloc = noAlloc;
+  #endif
+}
+// a caller may have looked up get/getU before an earlier call unpacked x, so both pass on calls for other types
+static B strlist_get(Arr* x, usz n) {
+  if (PTY(x)==t_strlist) strlist_unpack((StrList*)x);
+  return TIv(x,get)(x, n);
+}
+static B strlist_getU(Arr* x, usz n) {
+  if (PTY(x)==t_strlist) strlist_unpack((StrList*)x);
+  return TIv(x,getU)(x, n);
+}
+static Arr* strlist_slice(B x, usz s, usz ia) {
+  StrList* p = c(StrList,x);
+  StrList* r = m_strlistp(incG(p->chars), p->fill, ia);
+  memcpy(r->off, p->off+s, (ia+(u64)1)*sizeof(usz));
+  decG(x);
+  return (Arr*)r;
+}
+DEF_FREE(strlist) {
+  dec(((StrList*)x)->chars);
+  decSh(x);
+}
+static void strlist_visit(Value* x) {
+  mm_visit(((StrList*)x)->chars);
+  VISIT_SHAPE(x);
+}
+
+
+
+static StrList* strlist_tryCpy(B x) { // a strlist with the elements of x (ignoring its shape), or NULL if they aren't all character lists; doesn't consume
+  usz ia = IA(x);
+  SGetU(x)
+  u8 el = el_c8;
+  u64 total = 0;
+  for (usz i = 0; i < ia; i++) {
+    B c = GetU(x, i);
+    if (isAtm(c) || RNK(c)!=1) return NULL;
+    usz l = IA(c);
+    if (l==0) continue;
+    u8 ce = TI(c,elType);
+    if (!elChr(ce)) return NULL;
+    if (ce>el) el = ce;
+    total+= l;
+  }
+  if (total > USZ_MAX) thrOOM();
+  u8 w = elWidth(el);
+  B chars; u8* cp = m_tyarrv(&chars, w, total, chrArrType(el));
+  StrList* r = m_strlistp(chars, false, ia);
+  usz o = 0;
+  for (usz i = 0; i < ia; i++) {
+    B c = GetU(x, i);
+    usz l = IA(c);
+    r->off[i] = o;
+    if (l) COPY_TO(cp, el, o, c, 0, l);
+    o+= l;
+  }
+  r->off[ia] = o;
+  return r;
+}
+Arr* cpyStrList(B x) {
+  if (isStrList(x) && RNK(x)==1) { // copy the characters directly, as reading elements with GetU would unpack x
+    StrList* xs = c(StrList,x);
+    usz ia = IA(x), s = xs->off[0], l = xs->off[ia]-s;
+    u8 el = TI(xs->chars,elType);
+    B chars; void* cp = m_tyarrv(&chars, elWidth(el), l, chrArrType(el));
+    if (l) COPY_TO(cp, el, 0, xs->chars, s, l);
+    StrList* r = m_strlistp(chars, xs->fill, ia);
+    for (usz i = 0; i <= ia; i++) r->off[i] = xs->off[i]-s;
+    decG(x);
+    return (Arr*)r;
+  }
+  if (isArr(x) && RNK(x)==1) {
+    StrList* r = strlist_tryCpy(x);
+    if (r!=NULL) {
+      decG(x);
+      return (Arr*)r;
+    }
+  }
+  thrM("Expected a list of character lists");
+}
+
+typedef struct StrView { usz* off; u8* p; u8 w; B o; } StrView; // the strings of a strlist, with characters of width w; o keeps p alive
+static u8 strlist_el(StrList* x) { return TI(x->chars,elType); }
+static StrView strlist_view(StrList* x, u8 el) { // el must be at least strlist_el(x)
+  B c = incG(x->chars);
+  if (el!=strlist_el(x)) c = el==el_c16? toC16Any(c) : toC32Any(c);
+  return (StrView){.off = x->off, .p = tyany_ptr(c), .w = elWidth(el), .o = c};
+}
+static usz sv_len(StrView* v, usz i) { return v->off[i+1]-v->off[i]; }
+static u8* sv_ptr(StrView* v, usz i) { return v->p + v->off[i]*(u64)v->w; }
+static bool sv_eq(StrView* a, usz i, StrView* b, usz j) { // a and b must have the same width
+  usz l = sv_len(a, i);
+  return l==sv_len(b, j) && memcmp(sv_ptr(a, i), sv_ptr(b, j), l*(u64)a->w)==0;
+}
+
+B strlist_select(StrList* x, i32* ip, usz n) {
+  StrView v = strlist_view(x, strlist_el(x));
+  u64 total = 0;
+  for (usz i = 0; i < n; i++) total+= sv_len(&v, ip[i]);
+  if (total > USZ_MAX) thrOOM();
+  B chars; u8* cp = m_tyarrv(&chars, v.w, total, chrArrType(strlist_el(x)));
+  StrList* r = m_strlistp(chars, x->fill, n);
+  usz o = 0;
+  for (usz i = 0; i < n; i++) {
+    usz l = sv_len(&v, ip[i]);
+    r->off[i] = o;
+    memcpy(cp + o*(u64)v.w, sv_ptr(&v, ip[i]), l*(u64)v.w);
+    o+= l;
+  }
+  r->off[n] = o;
+  decG(v.o);
+  return taga(r);
+}
+
+B strlist_lengths(B x) {
+  usz n = IA(x);
+  usz* off = c(StrList,x)->off;
+  B r;
+  if (off[n]-off[0] <= I32_MAX) { i32* rp; r = m_i32arrc(&rp, x); for (usz i = 0; i < n; i++) rp[i] = off[i+1]-off[i]; }
+  else                          { f64* rp; r = m_f64arrc(&rp, x); for (usz i = 0; i < n; i++) rp[i] = off[i+1]-off[i]; }
+  decG(x);
+  return num_squeeze(r);
+}
+B strlist_join(B x) {
+  StrList* xs = c(StrList,x);
+  B c = xs->chars;
+  usz n = IA(x);
+  usz s = xs->off[0], l = xs->off[n]-s;
+  B r = s==0 && l==IA(c)? incG(c) : taga(arr_shVec(TI(c,slice)(incG(c), s, l)));
+  decG(x);
+  return r;
+}
+
+
+
+// open-addressing hash table of indices+1 into the strings of a StrView, with linear probing
+typedef struct StrTab { u32* t; u64 mask; u8 sh; StrView* v; } StrTab;
+static StrTab strlist_tab(StrView* v, usz n) {
+  u8 lg = 6;
+  while ((1ULL<<lg) < 2*(u64)n) lg++;
+  TALLOC(u32, t, 1ULL<<lg);
+  for (u64 i = 0; i < 1ULL<<lg; i++) t[i] = 0;
+  return (StrTab){ .t=t, .mask=(1ULL<<lg)-1, .sh=64-lg, .v=v };
+}
+static u64 strlist_slot(StrTab* h, StrView* q, usz j) { // slot holding an index of string j of q, or the empty slot where it'd go
+  u64 s = wyhash(sv_ptr(q, j), sv_len(q, j)*(u64)q->w, 0, wy_secret) >> h->sh;
+  u32 e;
+  while ((e = h->t[s])!=0 && !sv_eq(h->v, e-1, q, j)) s = (s+1) & h->mask;
+  return s;
+}
+
+B strlist_selfSearch(u8 rtid, B x) {
+  StrList* xs = c(StrList,x);
+  usz n = IA(x);
+  StrView v = strlist_view(xs, strlist_el(xs));
+  StrTab h = strlist_tab(&v, n);
+  B r;
+  if (rtid==n_indexOf) {
+    i32* rp; r = m_i32arrv(&rp, n);
+    i32 c = 0;
+    for (usz i = 0; i < n; i++) {
+      u64 s = strlist_slot(&h, &v, i);
+      if (h.t[s]) rp[i] = rp[h.t[s]-1];
+      else { h.t[s] = i+1; rp[i] = c++; }
+    }
+  } else if (rtid==n_memberOf) {
+    u64* rp; r = m_bitarrv(&rp, n);
+    for (usz i = 0; i < BIT_N(n); i++) rp[i] = 0;
+    for (usz i = 0; i < n; i++) {
+      u64 s = strlist_slot(&h, &v, i);
+      if (!h.t[s]) { h.t[s] = i+1; rp[i>>6]|= 1ULL<<(i&63); }
+    }
+  } else {
+    TALLOC(i32, u, n);
+    usz c = 0;
+    for (usz i = 0; i < n; i++) {
+      u64 s = strlist_slot(&h, &v, i);
+      if (!h.t[s]) { h.t[s] = i+1; u[c++] = i; }
+    }
+    r = strlist_select(xs, u, c);
+    TFREE(u);
+  }
+  TFREE(h.t);
+  decG(v.o);
+  decG(x);
+  return r;
+}
+B strlist_search(u8 rtid, B w, B x) {
+  if (!isArr(w) || !isArr(x)) return bi_N;
+  B l = rtid==n_indexOf? w : x; // the searched list
+  B e = rtid==n_indexOf? x : w; // the strings to look up
+  if (RNK(l)!=1 || IA(l)>=I32_MAX) return bi_N;
+  StrList* ls = isStrList(l)? ptr_inc(c(StrList,l)) : strlist_tryCpy(l);
+  if (ls==NULL) return bi_N;
+  StrList* es = isStrList(e)? ptr_inc(c(StrList,e)) : strlist_tryCpy(e);
+  if (es==NULL) { ptr_dec(ls); return bi_N; }
+  u8 el = strlist_el(ls)>strlist_el(es)? strlist_el(ls) : strlist_el(es);
+  StrView a = strlist_view(ls, el);
+  StrView b = strlist_view(es, el);
+  usz ln = IA(l), en = IA(e);
+  StrTab h = strlist_tab(&a, ln);
+  for (usz i = 0; i < ln; i++) { u64 s = strlist_slot(&h, &a, i); if (!h.t[s]) h.t[s] = i+1; }
+  B r;
+  if (rtid==n_indexOf) {
+    i32* rp; r = m_i32arrc(&rp, e);
+    for (usz i = 0; i < en; i++) { u32 c = h.t[strlist_slot(&h, &b, i)]; rp[i] = c? c-1 : ln; }
+  } else {
+    u64* rp; r = m_bitarrc(&rp, e);
+    for (usz i = 0; i < BIT_N(en); i++) rp[i] = 0;
+    for (usz i = 0; i < en; i++) if (h.t[strlist_slot(&h, &b, i)]) rp[i>>6]|= 1ULL<<(i&63);
+  }
+  TFREE(h.t);
+  decG(a.o); decG(b.o);
+  ptr_dec(ls); ptr_dec(es);
+  return r;
+}
+
+
+
+B strlist_from(B w, B x) {
+  if (!isArr(w) || RNK(w)!=1 || !elInt(TI(w,elType))) return bi_N;
+  StrList* xs = c(StrList,x);
+  usz n = IA(w), xn = PIA(xs);
+  B wi = toI32Any(incG(w));
+  i32* wp = i32any_ptr(wi);
+  TALLOC(i32, ip, n);
+  B r = bi_N;
+  for (usz i = 0; i < n; i++) {
+    i64 c = wp[i];
+    if (c<0) c+= xn;
+    if (c<0 || c>=(i64)xn) goto end; // let the regular primitive give the error
+    ip[i] = c;
+  }
+  r = strlist_select(xs, ip, n);
+  end:
+  TFREE(ip);
+  decG(wi);
+  return r;
+}
+
+
+
+void strlist_init(void) {
+  TIi(t_strlist,get)   = strlist_get;
+  TIi(t_strlist,getU)  = strlist_getU;
+  TIi(t_strlist,slice) = strlist_slice;
+  TIi(t_strlist,freeO) = strlist_freeO;
+  TIi(t_strlist,freeF) = strlist_freeF;
+  TIi(t_strlist,visit) = strlist_visit;
+  TIi(t_strlist,print) = farr_print;
+  TIi(t_strlist,isArr) = true;
+}
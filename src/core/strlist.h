@@ -0,0 +1,20 @@
+typedef struct StrList { // packed list of strings, stored as all of their characters back to back plus offsets
+  struct Arr;
+  B chars;   // character array (c8/c16/c32, possibly a slice); string i is chars[off[i]…off[i+1]), and there may be unused characters between strings
+  bool fill; // whether the list has the fill "" (from ⊔), or no fill (like •file.Lines used to give)
+  usz off[]; // ia+1 non-decreasing offsets into chars
+} StrList;
+
+#define STRLIST_MIN 32 // producers give regular arrays for lists of fewer strings
+static bool isStrList(B x) { return isArr(x) && TY(x)==t_strlist; }
+StrList* m_strlistp(B chars, bool fill, usz ia); // consumes chars; a list of ia strings, whose off the caller must fill in
+Arr* cpyStrList(B x); // consumes; x must be a list of character lists
+
+// primitives on the characters & offsets of a strlist x, called by the primitives themselves so that they don't read elements, which unpacks it (see strlist.c)
+B strlist_str(B x, usz i); // new copy of string i, for ⊑ and 𝕨⊑𝕩; doesn't consume
+B strlist_lengths(B x); // ≠¨; consumes
+B strlist_join(B x); // ∾ of a non-empty list x; consumes
+B strlist_selfSearch(u8 rtid, B x); // ⊐ ∊ ⍷ (by rtid) of a list x of fewer than 2⋆31 strings; consumes
+B strlist_search(u8 rtid, B w, B x); // 𝕨⊐𝕩 or 𝕨∊𝕩 with w or x a strlist; doesn't consume; bi_N if not applicable
+B strlist_from(B w, B x); // 𝕨⊏𝕩 for a list x; doesn't consume; bi_N if not applicable
+B strlist_select(StrList* x, i32* ip, usz n); // new strlist of the strings at indices ip, which must be in bounds
@@ -397,6 +397,7 @@ NOINLINE NORETURN void expU_f64(f64 what) {
 usz depthF(B x) { // doesn't consume
   u64 r = 0;
   usz ia = IA(x);
+  if (TY(x)==t_strlist) return ia? 2 : 1;
   SGetU(x)
   for (usz i = 0; i < ia; i++) {
     u64 n = depth(GetU(x,i));
@@ -32,7 +32,7 @@ u8 const arrTypeWidthLog[] = {
   [t_i16arr]=1, [t_i16slice]=1, [t_c16arr]=1, [t_c16slice]=1,
   [t_i32arr]=2, [t_i32slice]=2, [t_c32arr]=2, [t_c32slice]=2,
   [t_f64arr]=3, [t_f64slice]=3,
-  [t_harr  ]=3, [t_hslice  ]=3, [t_fillarr]=3,[t_fillslice]=3
+  [t_harr  ]=3, [t_hslice  ]=3, [t_fillarr]=3,[t_fillslice]=3, [t_strlist]=3
 };
 u8 const arrTypeBitsLog[] = {
   [t_bitarr]=0,
@@ -40,7 +40,7 @@ u8 const arrTypeBitsLog[] = {
   [t_i16arr]=4, [t_i16slice]=4, [t_c16arr]=4, [t_c16slice]=4,
   [t_i32arr]=5, [t_i32slice]=5, [t_c32arr]=5, [t_c32slice]=5,
   [t_f64arr]=6, [t_f64slice]=6,
-  [t_harr  ]=6, [t_hslice  ]=6, [t_fillarr]=6,[t_fillslice]=6
+  [t_harr  ]=6, [t_hslice  ]=6, [t_fillarr]=6,[t_fillslice]=6, [t_strlist]=6
 };
 
 #define TU I8
@@ -97,7 +97,7 @@ static void bitarr_init(void) {
   TIi(t_bitarr,canStore) = bitarr_canStore;
 }
 
-INIT_GLOBAL Arr* staticSliceRoot;
+GLOBAL Arr* staticSliceRoot;
 void tyarr_init(void) {
   i8arr_init(); i16arr_init(); i32arr_init(); bitarr_init();
   c8arr_init(); c16arr_init(); c32arr_init(); f64arr_init();
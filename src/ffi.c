@@ -1,3 +1,6 @@
+#if MULTI_INSTANCE
+  #define _GNU_SOURCE 1 // for dl_iterate_phdr
+#endif
 #include "core.h"
 
 #if FFI && !defined(CBQN_EXPORT)
@@ -50,6 +53,131 @@ BQN_EXP void bqn_init() {
   cbqn_init();
 }
 
+#if MULTI_INSTANCE
+// All GLOBALs are thread-local, so the static TLS block of this module is the complete state of the interpreter entered
+// on a thread, and switching instances is copying that block out & in. Objects and the GC root list refer to GLOBALs by
+// address, which differs between threads, so an instance must stay on the thread it was created on.
+// The bookkeeping below is per-thread too, but mustn't be swapped along with the state, so it's kept in a pthread key
+// instead of a __thread variable (which would land in the same TLS block).
+#include <link.h>
+#include <pthread.h>
+struct bqn_instance {
+  u8* tls; // the TLS block of the thread this instance lives on
+  u8* state; // copy of the TLS block while not entered
+};
+typedef struct InstanceThread {
+  void* code; // an address in this module, to find it by
+  u8* tls; // this thread's TLS block
+  u8* init; u64 initSz; // the initial TLS image
+  u64 sz;
+  bqn_instance* curr; // instance whose state is in the TLS block; NULL if the thread's default state hasn't been given a handle
+} InstanceThread;
+extern GLOBAL bool cbqn_initialized;
+static pthread_key_t inst_key;
+static pthread_once_t inst_keyOnce = PTHREAD_ONCE_INIT;
+
+static int inst_findTLS(struct dl_phdr_info* info, size_t size, void* ctx) {
+  InstanceThread* r = ctx;
+  const ElfW(Phdr)* tls = NULL;
+  bool ours = false;
+  for (i32 i = 0; i < info->dlpi_phnum; i++) {
+    const ElfW(Phdr)* h = &info->dlpi_phdr[i];
+    if (h->p_type==PT_TLS) tls = h;
+    if (h->p_type==PT_LOAD && ptr2u64(r->code) - (info->dlpi_addr + h->p_vaddr) < h->p_memsz) ours = true;
+  }
+  if (!ours) return 0;
+  if (tls!=NULL) {
+    r->tls = info->dlpi_tls_data;
+    r->init = (u8*)(info->dlpi_addr + tls->p_vaddr);
+    r->initSz = tls->p_filesz;
+    r->sz = tls->p_memsz;
+  }
+  return 1;
+}
+static void inst_freeThread(void* p) {
+  InstanceThread* t = p;
+  if (t->curr!=NULL && t->curr->state==NULL) free(t->curr); // a handle that was never switched away from; others belong to the embedder
+  free(t);
+}
+static void inst_makeKey() {
+  if (pthread_key_create(&inst_key, inst_freeThread)) fatal("Failed to allocate instance bookkeeping");
+}
+static InstanceThread* inst_thread() {
+  pthread_once(&inst_keyOnce, inst_makeKey);
+  InstanceThread* r = pthread_getspecific(inst_key);
+  if (r==NULL) {
+    r = calloc(1, sizeof(InstanceThread));
+    r->code = (void*)inst_findTLS;
+    *(volatile bool*)&cbqn_initialized; // the TLS block of a dlopen-ed module is allocated on first use, and isn't reported before that
+    dl_iterate_phdr(inst_findTLS, r);
+    if (r->tls==NULL) fatal("Failed to locate interpreter state");
+    pthread_setspecific(inst_key, r);
+  }
+  return r;
+}
+static void inst_load(InstanceThread* t, bqn_instance* i) { // i==NULL resets to a fresh uninitialized interpreter, with no handle yet
+  if (i) memcpy(t->tls, i->state, t->sz);
+  else {
+    memcpy(t->tls, t->init, t->initSz);
+    memset(t->tls+t->initSz, 0, t->sz-t->initSz);
+  }
+  t->curr = i;
+}
+
+static bqn_instance* inst_current(InstanceThread* t) {
+  if (t->curr==NULL) {
+    t->curr = malloc(sizeof(bqn_instance));
+    *t->curr = (bqn_instance){.tls = t->tls, .state = NULL};
+  }
+  return t->curr;
+}
+BQN_EXP bqn_instance* bqn_currentInstance() {
+  return inst_current(inst_thread());
+}
+static void inst_save(InstanceThread* t) {
+  bqn_instance* c = inst_current(t);
+  if (c->state==NULL) c->state = malloc(t->sz);
+  memcpy(c->state, t->tls, t->sz);
+}
+BQN_EXP void bqn_enter(bqn_instance* i) {
+  InstanceThread* t = inst_thread();
+  if (i==t->curr) return;
+  if (i->tls!=t->tls) fatal("bqn_enter: instance used on a thread other than the one it was created on");
+  inst_save(t);
+  inst_load(t, i);
+}
+BQN_EXP bqn_instance* bqn_newInstance() {
+  InstanceThread* t = inst_thread();
+  bqn_instance* prev = inst_current(t);
+  inst_save(t);
+  inst_load(t, NULL);
+  cbqn_init();
+  bqn_instance* r = inst_current(t);
+  inst_save(t);
+  inst_load(t, prev);
+  return r;
+}
+void vm_freeStacks(void);
+BQN_EXP void bqn_freeInstance(bqn_instance* i) {
+  InstanceThread* t = inst_thread();
+  if (i->tls!=t->tls) fatal("bqn_freeInstance: instance used on a thread other than the one it was created on");
+  bqn_instance* prev = i==t->curr? NULL : inst_current(t);
+  bqn_enter(i);
+  if (cbqn_initialized) {
+    mm_freeArenas();
+    vm_freeStacks();
+  }
+  inst_load(t, prev);
+  free(i->state);
+  free(i);
+}
+#else
+BQN_EXP bqn_instance* bqn_newInstance() { return NULL; }
+BQN_EXP bqn_instance* bqn_currentInstance() { return NULL; }
+BQN_EXP void bqn_enter(bqn_instance* i) { }
+BQN_EXP void bqn_freeInstance(bqn_instance* i) { }
+#endif
+
 B type_c1(B t, B x);
 static i32 typeInt(B x) { // doesn't consume
   return o2i(C1(type, inc(x)));
@@ -721,23 +849,38 @@ static void genObj_writePtr(void* res, B c, B expEl, B* sourceObjs) {
   *(void**)res = ptrh_ptr(h);
   if (sourceObjs!=NULL) *sourceObjs = vec_addN(*sourceObjs, incG(c)); 
 }
+static void genObj_scalar(u32 t, B c, void* ptr) { // doesn't consume
+  f64 f = c.f;
+  switch(t) { default: UD; // thrF("FFI: Unimplemented scalar type \"%S\"", sty_names[t]);
+    case sty_a:   *(BQNV*)ptr = makeX(inc(c)); break;
+    case sty_u8:  { if(!q_fu8 (f)) thrM("FFI: improper value for u8" ); *( u8*)ptr = ( u8)f; break; }
+    case sty_i8:  { if(!q_fi8 (f)) thrM("FFI: improper value for i8" ); *( i8*)ptr = ( i8)f; break; }
+    case sty_u16: { if(!q_fu16(f)) thrM("FFI: improper value for u16"); *(u16*)ptr = (u16)f; break; }
+    case sty_i16: { if(!q_fi16(f)) thrM("FFI: improper value for i16"); *(i16*)ptr = (i16)f; break; }
+    case sty_u32: { if(!q_fu32(f)) thrM("FFI: improper value for u32"); *(u32*)ptr = (u32)f; break; }
+    case sty_i32: { if(!q_fi32(f)) thrM("FFI: improper value for i32"); *(i32*)ptr = (i32)f; break; }
+    case sty_u64: { if(!q_fu64(f)) thrM("FFI: improper value for u64"); u64 i=(u64)f; if (i>=(1ULL<<53))                 thrM("FFI: u64 argument value ≥ 2⋆53");          *(u64*)ptr = i; break; }
+    case sty_i64: { if(!q_fi64(f)) thrM("FFI: improper value for i64"); i64 i=(i64)f; if (i>=(1LL<<53) || i<=-(1LL<<53)) thrM("FFI: i64 argument absolute value ≥ 2⋆53"); *(i64*)ptr = i; break; }
+    case sty_f32: { if(!isNum(c))  thrM("FFI: improper value for f32"); *(float* )ptr = f; break; }
+    case sty_f64: { if(!isNum(c))  thrM("FFI: improper value for f64"); *(double*)ptr = f; break; }
+  }
+}
+static NOINLINE B genObj_numPtr(B o, u32 elt, B c, bool mut) { // o is the type for error messages; returns a typed array whose data can be passed as the pointer; doesn't consume
+  incG(c);
+  switch(elt) { default: thrF("FFI: Unimplemented pointer element type within %R", ty_fmt(o));
+    case sty_i8:  ffi_numRange(c, mut, "i8",  I8_MIN,  I8_MAX);  return mut? taga(cpyI8Arr (c)) : toI8Any (c);
+    case sty_i16: ffi_numRange(c, mut, "i16", I16_MIN, I16_MAX); return mut? taga(cpyI16Arr(c)) : toI16Any(c);
+    case sty_i32: ffi_numRange(c, mut, "i32", I32_MIN, I32_MAX); return mut? taga(cpyI32Arr(c)) : toI32Any(c);
+    case sty_f64: ffi_numRange(c, mut, "f64", 0, 0);             return mut? taga(cpyF64Arr(c)) : toF64Any(c);
+    case sty_u8:  ffi_numRange(c, mut, "u8",  0, U8_MAX);        return mut?     cpyU8Bits (c) : toU8Bits (c);
+    case sty_u16: ffi_numRange(c, mut, "u16", 0, U16_MAX);       return mut?     cpyU16Bits(c) : toU16Bits(c);
+    case sty_u32: ffi_numRange(c, mut, "u32", 0, U32_MAX);       return mut?     cpyU32Bits(c) : toU32Bits(c);
+    case sty_f32: ffi_numRange(c, mut, "f32", 0, 0);             return cpyF32Bits(c); // no direct f32 type, so no direct reference option
+  }
+}
 void genObj(B o, B c, void* ptr, B* sourceObjs) { // doesn't consume
   if (isC32(o)) { // scalar
-    u32 t = styG(o);
-    f64 f = c.f;
-    switch(t) { default: UD; // thrF("FFI: Unimplemented scalar type \"%S\"", sty_names[t]);
-      case sty_a:   *(BQNV*)ptr = makeX(inc(c)); break;
-      case sty_u8:  { if(!q_fu8 (f)) thrM("FFI: improper value for u8" ); *( u8*)ptr = ( u8)f; break; }
-      case sty_i8:  { if(!q_fi8 (f)) thrM("FFI: improper value for i8" ); *( i8*)ptr = ( i8)f; break; }
-      case sty_u16: { if(!q_fu16(f)) thrM("FFI: improper value for u16"); *(u16*)ptr = (u16)f; break; }
-      case sty_i16: { if(!q_fi16(f)) thrM("FFI: improper value for i16"); *(i16*)ptr = (i16)f; break; }
-      case sty_u32: { if(!q_fu32(f)) thrM("FFI: improper value for u32"); *(u32*)ptr = (u32)f; break; }
-      case sty_i32: { if(!q_fi32(f)) thrM("FFI: improper value for i32"); *(i32*)ptr = (i32)f; break; }
-      case sty_u64: { if(!q_fu64(f)) thrM("FFI: improper value for u64"); u64 i=(u64)f; if (i>=(1ULL<<53))                 thrM("FFI: u64 argument value ≥ 2⋆53");          *(u64*)ptr = i; break; }
-      case sty_i64: { if(!q_fi64(f)) thrM("FFI: improper value for i64"); i64 i=(i64)f; if (i>=(1LL<<53) || i<=-(1LL<<53)) thrM("FFI: i64 argument absolute value ≥ 2⋆53"); *(i64*)ptr = i; break; }
-      case sty_f32: { if(!isNum(c))  thrM("FFI: improper value for f32"); *(float* )ptr = f; break; }
-      case sty_f64: { if(!isNum(c))  thrM("FFI: improper value for f64"); *(double*)ptr = f; break; }
-    }
+    genObj_scalar(styG(o), c, ptr);
   } else {
     BQNFFIType* t = c(BQNFFIType, o);
     if (t->ty==cty_ptr || t->ty==cty_tlarr) { // *any / &any / top-level [n]any
@@ -750,20 +893,7 @@ void genObj(B o, B c, void* ptr, B* sourceObjs) { // doesn't consume
       usz ia = IA(c);
       if (t->ty==cty_tlarr && t->arrCount!=ia) thrF("FFI: Incorrect item count of %s corresponding to %R", ia, ty_fmt(o));
       if (isC32(e)) { // *num / &num
-        incG(c);
-        B cG;
-        bool mut = t->ty==cty_ptr? t->mutPtr : false;
-        switch(styG(e)) { default: thrF("FFI: Unimplemented pointer element type within %R", ty_fmt(o));
-          case sty_i8:  ffi_numRange(c, mut, "i8",  I8_MIN,  I8_MAX);  cG = mut? taga(cpyI8Arr (c)) : toI8Any (c); break;
-          case sty_i16: ffi_numRange(c, mut, "i16", I16_MIN, I16_MAX); cG = mut? taga(cpyI16Arr(c)) : toI16Any(c); break;
-          case sty_i32: ffi_numRange(c, mut, "i32", I32_MIN, I32_MAX); cG = mut? taga(cpyI32Arr(c)) : toI32Any(c); break;
-          case sty_f64: ffi_numRange(c, mut, "f64", 0, 0);             cG = mut? taga(cpyF64Arr(c)) : toF64Any(c); break;
-          case sty_u8:  ffi_numRange(c, mut, "u8",  0, U8_MAX);        cG = mut?     cpyU8Bits (c) : toU8Bits (c); break;
-          case sty_u16: ffi_numRange(c, mut, "u16", 0, U16_MAX);       cG = mut?     cpyU16Bits(c) : toU16Bits(c); break;
-          case sty_u32: ffi_numRange(c, mut, "u32", 0, U32_MAX);       cG = mut?     cpyU32Bits(c) : toU32Bits(c); break;
-          case sty_f32: ffi_numRange(c, mut, "f64", 0, 0);             cG = cpyF32Bits(c); break; // no direct f32 type, so no direct reference option
-        }
-        
+        B cG = genObj_numPtr(o, styG(e), c, t->ty==cty_ptr? t->mutPtr : false);
         *(void**)ptr = tyany_ptr(cG);
         *sourceObjs = vec_addN(*sourceObjs, cG);
       } else { // *{...} / &{...} / *[n]any
@@ -942,6 +1072,84 @@ B readUpdatedObj(BQNFFIEnt ent, bool anyMut, B** objs) {
   } else thrF("FFI: Unimplemented type (readUpdatedObj: %i)", (i32)t->ty);
 }
 
+// pass a &-argument array directly if it's exactly of the type that'd be passed, and nothing else can observe it being modified
+static bool genObj_mutInPlace(B o, B c, void* ptr, B* sourceObjs) { // doesn't consume; returns whether the argument was written
+  if (!isArr(c) || !reusable(c)) return false;
+  BQNFFIType* t = c(BQNFFIType, o);
+  u8 ty;
+  if (t->ty==cty_ptr) { // &num
+    if (!t->mutPtr || !isC32(t->a[0].o)) return false;
+    switch (styG(t->a[0].o)) { default: return false;
+      case sty_i8:  ty = t_i8arr;  break;
+      case sty_i16: ty = t_i16arr; break;
+      case sty_i32: ty = t_i32arr; break;
+      case sty_f64: ty = t_f64arr; break;
+    }
+  } else if (t->ty==cty_repr) { // &scalar:any
+    B o2 = t->a[0].o;
+    if (isC32(o2)) return false;
+    BQNFFIType* t2 = c(BQNFFIType, o2);
+    B ore = t2->a[0].o;
+    if (!t2->mutPtr || !isC32(ore) || ore.u==m_c32(sty_void).u) return false;
+    u8 reW = t->reWidth;
+    u8 mul = (sty_w[styG(ore)]*8) >> reW;
+    if (mul && (IA(c) & (mul-1)) != 0) return false; // leave erroring to genObj
+    if (t->reType=='c') { if (reW<3 || reW>5) return false; ty = reTyMapC[reW]; }
+    else ty = reTyMapI[reW];
+  } else return false;
+  if (TY(c) != ty) return false;
+  *(void**)ptr = tyarr_ptr(c);
+  *sourceObjs = vec_addN(*sourceObjs, incG(REUSE(c))); // REUSE as the written data needn't match c's flags
+  return true;
+}
+static bool ffi_ownsItems(B l) { // whether items of l with reference count 1 are referenced only by l
+  return isArr(l) && reusable(l) && (TY(l)==t_harr || TY(l)==t_fillarr);
+}
+
+static B readResult(B o, void* res) {
+  if (isC32(o)) return readSimple(styG(o), res);
+  BQNFFIType* t = c(BQNFFIType, o);
+  if (t->ty == cty_repr) return readRe(t, res); // scalar:any, *:any
+  if (t->ty == cty_struct) return readStruct(t, res); // {...}
+  if (t->ty == cty_ptr) return m_ptrobj_s(*(void**)res, inc(t->a[0].o)); // *...
+  UD;
+}
+
+// marshaling plan: made at •FFI time for functions whose arguments are all scalars or read-only pointers to numbers, i.e. for which
+// genObj wouldn't recurse and nothing needs to be read back; such calls write arguments to a stack buffer and skip building ffiObjs
+#define FFI_PLAN_BUF 512 // max staticAllocTotal for a planned function
+typedef struct FFIPlanEnt {
+  u8 sty; // type of scalar, or element type of pointer
+  bool isPtr, onW, wholeArg;
+  u32 offset;
+} FFIPlanEnt;
+
+static B ffi_makePlan(BQNFFIType* ap, usz argn) { // returns m_f64(0) if the arguments aren't simple enough
+  if (ap->staticAllocTotal > FFI_PLAN_BUF) return m_f64(0);
+  for (usz i = 0; i < argn; i++) {
+    BQNFFIEnt e = ap->a[i+1];
+    if (e.isMutated) return m_f64(0);
+    if (isC32(e.o)) continue;
+    BQNFFIType* t = c(BQNFFIType, e.o);
+    if (t->ty!=cty_ptr || !isC32(t->a[0].o)) return m_f64(0);
+    u32 elt = styG(t->a[0].o);
+    if (elt==sty_void || elt==sty_a || elt==sty_u64 || elt==sty_i64) return m_f64(0);
+  }
+  
+  TAlloc* po = ARBOBJ(sizeof(FFIPlanEnt)*(argn? argn : 1)); // an object needs at least 16 bytes
+  FFIPlanEnt* plan = (FFIPlanEnt*)po->data;
+  for (usz i = 0; i < argn; i++) {
+    BQNFFIEnt e = ap->a[i+1];
+    bool isPtr = !isC32(e.o);
+    plan[i] = (FFIPlanEnt){
+      .sty = styG(isPtr? c(BQNFFIType, e.o)->a[0].o : e.o),
+      .isPtr = isPtr, .onW = e.onW, .wholeArg = e.wholeArg,
+      .offset = e.staticOffset
+    };
+  }
+  return tag(po, OBJ_TAG);
+}
+
 B libffiFn_c2(B t, B w, B x) {
   BoundFn* bf = c(BoundFn,t);
   BQNFFIType* argObj = c(BQNFFIType, c(HArr,bf->obj)->a[0]);
@@ -966,15 +1174,46 @@ B libffiFn_c2(B t, B w, B x) {
   
   i32 idxs[2] = {0,0};
   
-  u8* tmpAlloc = TALLOCP(u8, argObj->staticAllocTotal);
-  void** argPtrs = (void**) tmpAlloc;
-  
   B cifObj = c(HArr,bf->obj)->a[1];
   ffi_cif* cif = (void*) c(TAlloc,cifObj)->data;
   usz argn = cif->nargs;
   
   BQNFFIEnt* ents = argObj->a;
+  
+  B planObj = c(HArr,bf->obj)->a[3];
+  if (isObj(planObj)) {
+    FFIPlanEnt* plan = (FFIPlanEnt*) c(TAlloc,planObj)->data;
+    _Alignas(max_align_t) u8 buf[FFI_PLAN_BUF];
+    void** argPtrs = (void**) buf;
+    usz heldn = 0; // converted pointer arguments are kept on gStack, so that they're freed if a later argument errors
+    for (usz i = 0; i < argn; i++) {
+      FFIPlanEnt e = plan[i];
+      B o = e.wholeArg? (e.onW? w : x) : (e.onW? wf : xf)(e.onW?wa:xa, idxs[e.onW]++);
+      void* ptr = buf + e.offset;
+      argPtrs[i] = ptr;
+      if (!e.isPtr) {
+        genObj_scalar(e.sty, o, ptr);
+      } else if (isArr(o)) {
+        B cG = genObj_numPtr(ents[i+1].o, e.sty, o, false);
+        gsAdd(cG); heldn++;
+        *(void**)ptr = tyany_ptr(cG);
+      } else {
+        if (!isNsp(o)) thrF("FFI: Expected array or pointer object corresponding to %R", ty_fmt(ents[i+1].o));
+        genObj_writePtr(ptr, o, c(BQNFFIType, ents[i+1].o)->a[0].o, NULL);
+      }
+    }
+    void* res = buf + ents[0].staticOffset;
+    ffi_call(cif, bf->w_c2, res, argPtrs);
+    B r = readResult(ents[0].o, res);
+    for (usz i = 0; i < heldn; i++) decG(gsPop());
+    dec(w); dec(x);
+    return r;
+  }
+  
+  u8* tmpAlloc = TALLOCP(u8, argObj->staticAllocTotal);
+  void** argPtrs = (void**) tmpAlloc;
   B ffiObjs = emptyHVec(); // implicit parameter to genObj
+  bool owned[2] = {ffi_ownsItems(x), ffi_ownsItems(w)};
   for (usz i = 0; i < argn; i++) {
     BQNFFIEnt e = ents[i+1];
     B o;
@@ -983,6 +1222,7 @@ B libffiFn_c2(B t, B w, B x) {
     } else {
       o = (e.onW? wf : xf)(e.onW?wa:xa, idxs[e.onW]++);
     }
+    if (e.isMutated && (e.wholeArg || owned[e.onW]) && genObj_mutInPlace(e.o, o, tmpAlloc + e.staticOffset, &ffiObjs)) continue;
     genObj(e.o, o, tmpAlloc + e.staticOffset, &ffiObjs);
   }
   
@@ -999,22 +1239,8 @@ B libffiFn_c2(B t, B w, B x) {
   void* sym = bf->w_c2;
   ffi_call(cif, sym, res, argPtrs);
   
-  B r;
-  bool resVoid = false;
-  if (isC32(ents[0].o)) {
-    u32 resCType = styG(ents[0].o);
-    r = readSimple(resCType, res);
-    resVoid = resCType==sty_void;
-  } else {
-    BQNFFIType* t = c(BQNFFIType, ents[0].o);
-    if (t->ty == cty_repr) { // scalar:any, *:any
-      r = readRe(t, res);
-    } else if (t->ty == cty_struct) { // {...}
-      r = readStruct(c(BQNFFIType, ents[0].o), res);
-    } else if (t->ty == cty_ptr) { // *...
-      r = m_ptrobj_s(*(void**)res, inc(t->a[0].o));
-    } else UD;
-  }
+  B r = readResult(ents[0].o, res);
+  bool resVoid = ents[0].o.u == m_c32(sty_void).u;
   TFREE(tmpAlloc);
   
   i32 mutArgs = bf->mutCount;
@@ -1177,7 +1403,8 @@ B ffiload_c2(B t, B w, B x) {
   if (s!=FFI_OK) thrM("FFI: Error preparing call interface");
   
   u32 flags = eRes.resSingle<<2;
-  B r = m_ffiFn(foreignFnDesc, m_hvec3(argObj, tag(cif, OBJ_TAG), tag(ao, OBJ_TAG)), libffiFn_c1, libffiFn_c2, TOPTR(void,flags), sym);
+  B plan = ffi_makePlan(ap, argn);
+  B r = m_ffiFn(foreignFnDesc, m_hvec4(argObj, tag(cif, OBJ_TAG), tag(ao, OBJ_TAG), plan), libffiFn_c1, libffiFn_c2, TOPTR(void,flags), sym);
   c(BoundFn,r)->mutCount = mutCount;
   c(BoundFn,r)->wLen = whole[1]? -1 : count[1];
   c(BoundFn,r)->xLen = whole[0]? -1 : count[0];
@@ -15,9 +15,21 @@
 #ifndef SFNS_FILLS
   #define SFNS_FILLS 1
 #endif
+#ifndef FUSE_TRAINS
+  #define FUSE_TRAINS 0
+#endif
 #ifndef MM
   #define MM 1
 #endif
+#ifndef HEAP_IMAGE
+  #define HEAP_IMAGE 0
+#endif
+#ifndef MULTI_INSTANCE
+  #define MULTI_INSTANCE 0
+#endif
+#ifndef PARALLEL
+  #define PARALLEL 0
+#endif
 #ifndef HEAP_MAX
   #define HEAP_MAX ~0ULL
 #endif
@@ -150,9 +162,25 @@ typedef size_t ux;
 #define JOIN(A,B) JOIN0(A,B)
 #define STR0(X) #X
 #define STR1(X) STR0(X)
-#define INIT_GLOBAL __attribute__((visibility("hidden"))) // global variable set once during initialization, to the same value always
+#if HEAP_IMAGE && MULTI_INSTANCE
+  #error "HEAP_IMAGE and MULTI_INSTANCE can't be used together"
+#endif
+#if MULTI_INSTANCE && MM==0
+  #error "MULTI_INSTANCE requires MM=1 or MM=2"
+#endif
+#if PARALLEL && (MULTI_INSTANCE || !(defined(__unix__) || defined(__APPLE__)) || WASM)
+  #error "PARALLEL requires fork(), and can't be used with MULTI_INSTANCE"
+#endif
+#if HEAP_IMAGE
+  #define GLOBAL_SECTION __attribute__((section("cbqn_state"))) // kept together so that a heap image can save & restore all of them
+#elif MULTI_INSTANCE
+  #define GLOBAL_SECTION __thread // each thread has its own interpreter state, swapped between instances by bqn_enter
+#else
+  #define GLOBAL_SECTION
+#endif
+#define INIT_GLOBAL GLOBAL_SECTION __attribute__((visibility("hidden"))) // global variable set once during initialization, to the same value always
 #define GLOBAL INIT_GLOBAL // global variable mutated potentially multiple times, or set to a value referencing the heap
-#define STATIC_GLOBAL static // GLOBAL but static
+#define STATIC_GLOBAL static GLOBAL_SECTION // GLOBAL but static
 
 
 #if USE_REPLXX_IO
@@ -229,6 +257,11 @@ FORCE_INLINE B r_fB(f64 x) { return b(x); }
 #if DEBUG && !defined(VERIFY_TAIL) && MM==1
   #define VERIFY_TAIL 64
 #endif
+#if ALLOC_SITES
+  extern GLOBAL u32 allocSites_period; // record the allocation site of every n'th allocation; 0 when not recording
+  u32 allocSites_sample(void);
+  #define ALLOC_SITE(X) ((X)->site = RARE(allocSites_period)? allocSites_sample() : 0)
+#endif
 #if ALLOC_STAT || VERIFY_TAIL
   #define ALLOC_NOINLINE 1
 #endif
@@ -252,13 +285,13 @@ FORCE_INLINE B r_fB(f64 x) { return b(x); }
   \
   /*12*/ F(hslice) F(fillslice) F(i8slice) F(i16slice) F(i32slice) F(c8slice) F(c16slice) F(c32slice) F(f64slice) \
   /*21*/ F(harr  ) F(fillarr  ) F(i8arr  ) F(i16arr  ) F(i32arr  ) F(c8arr  ) F(c16arr  ) F(c32arr  ) F(f64arr  ) \
-  /*30*/ F(bitarr) \
+  /*30*/ F(bitarr) F(strlist) \
   \
-  /*31*/ F(comp) F(block) F(body) F(scope) F(scopeExt) F(blBlocks) F(arbObj) F(ffiType) \
-  /*39*/ F(ns) F(nsDesc) F(fldAlias) F(arrMerge) F(vfyObj) F(hashmap) F(temp) F(talloc) F(nfn) F(nfnDesc) \
-  /*49*/ F(freed) F(invalid) F(harrPartial) F(customObj) F(mmapH) \
+  /*32*/ F(comp) F(block) F(body) F(scope) F(scopeExt) F(blBlocks) F(arbObj) F(ffiType) \
+  /*40*/ F(ns) F(nsDesc) F(fldAlias) F(arrMerge) F(vfyObj) F(hashmap) F(temp) F(talloc) F(nfn) F(nfnDesc) \
+  /*50*/ F(freed) F(invalid) F(harrPartial) F(customObj) F(mmapH) \
   \
-  /*54*/ IF_WRAP(F(funWrap) F(md1Wrap) F(md2Wrap))
+  /*55*/ IF_WRAP(F(funWrap) F(md1Wrap) F(md2Wrap))
 
 enum Type {
   #define F(X) t_##X,
@@ -266,7 +299,7 @@ enum Type {
   #undef F
   t_COUNT
 };
-#define IS_ANY_ARR(T) ((T)>=t_hslice & (T)<=t_bitarr)
+#define IS_ANY_ARR(T) ((T)>=t_hslice & (T)<=t_strlist)
 #define IS_DIRECT_TYARR(T) (((T)>=t_i8arr) & ((T)<=t_bitarr))
 #define IS_SLICE(T) ((T)<=t_f64slice)
 #define TO_SLICE(T) ((T) + t_hslice - t_harr) // Assumes T!=t_bitarr
@@ -294,6 +327,9 @@ typedef struct Value {
   u8 flags;  // self-hosted primitive index (plus 1) for callable, fl_* flags for arrays
   u8 type;   // used by TI, among generally knowing what type of object this is
   ur extra;  // whatever object-specific stuff. Rank for arrays, internal id for functions
+  #if ALLOC_SITES
+  u32 site;  // index of the source position that allocated this object; 0 if unknown or not sampled
+  #endif
   #if OBJ_COUNTER
   u64 uid;
   #endif
@@ -352,6 +388,11 @@ u64 tot_heapUsed(void);
 #if HEAP_VERIFY
   void cbqn_heapVerify(void);
 #endif
+#if HEAP_IMAGE
+  typedef struct HeapArena { void* p; u64 sz; void* mapP; u64 mapSz; } HeapArena; // an allocator arena, and the memory mapping containing it
+  bool heapImage_load(void); // restore the initialized state from the image if there's a usable one; returns whether it did
+  void heapImage_write(char* path); // write an image of the current state; must be called at top level
+#endif
 
 // some primitive actions
 static const B bi_N      = b((u64)0x7FF2000000000000ull);
@@ -359,6 +400,7 @@ static const B bi_noVar  = b((u64)0x7FF2C00000000001ull);
 static const B bi_okHdr  = b((u64)0x7FF2000000000002ull);
 static const B bi_optOut = b((u64)0x7FF2800000000003ull);
 static const B bi_noFill = b((u64)0x7FF2000000000005ull);
+static const B bi_tailCall = b((u64)0x7FF2000000000006ull); // returned by a body that ended in a tail call stored in vm_tailCall; never escapes execBodyInplaceI
 extern GLOBAL B bi_emptyHVec, bi_emptyIVec, bi_emptyCVec, bi_emptySVec;
 #define emptyHVec() incG(bi_emptyHVec)
 #define emptyIVec() incG(bi_emptyIVec)
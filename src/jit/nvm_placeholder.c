@@ -4,3 +4,7 @@ B evalJIT(Body* b, Scope* sc, u8* ptr) { thrM("JIT: Not supported"); }
 Nvm_res m_nvm(Body* b) { thrM("JIT: Not supported"); }
 void nvm_free(u8* ptr) { thrM("JIT: Not supported"); }
 void mmX_dumpHeap(FILE* f) { }
+#if HEAP_IMAGE
+  u64 mmX_imageArenas(HeapArena* r) { return 0; }
+  void mmX_imageRestore(HeapArena* a, u64 n) { }
+#endif
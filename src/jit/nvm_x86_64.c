@@ -1,6 +1,7 @@
 #include "../core.h"
 #include "../core/gstack.h"
 #include "../ns.h"
+#include "../utils/cpu.h"
 #include "../utils/file.h"
 #include "../utils/talloc.h"
 #include "../utils/wyhash.h"
@@ -94,6 +95,45 @@ INS B i_FN1C(B f, B x, u32* bc) { POS_UPD; // TODO figure out a way to instead p
   B r = c1(f, x);
   dec(f); return r;
 }
+// quickened FN1C/FN2C; the machine code can't be rewritten, so a failed guard just makes the call the generic way
+INS B i_FN1B(B f, B x, u32* bc) { POS_UPD;
+  B r;
+  if (RARE(!isFun(f) || TY(f)!=t_funBI)) r = c1(f, x);
+  else r = VALIDATE(c1G(f, x));
+  dec(f); return r;
+}
+INS B i_FN2B(B w, B f, B x, u32* bc) { POS_UPD;
+  B r;
+  if (RARE(!isFun(f) || TY(f)!=t_funBI)) r = c2(f, w, x);
+  else r = VALIDATE(c2G(f, w, x));
+  dec(f); return r;
+}
+INS B i_FN1K(B f, B x, u32* bc) { POS_UPD;
+  B r;
+  if (RARE(!isFun(f) || TY(f)!=t_funBl)) r = c1(f, x);
+  else r = funBl_c1(f, x);
+  dec(f); return r;
+}
+INS B i_FN2K(B w, B f, B x, u32* bc) { POS_UPD;
+  B r;
+  if (RARE(!isFun(f) || TY(f)!=t_funBl)) r = c2(f, w, x);
+  else r = funBl_c2(f, w, x);
+  dec(f); return r;
+}
+// FN1C/FN1O/FN2C/FN2O and their quickened versions directly followed by RETN; see vm_setTailCall
+// the checks for · are those of FN1O/FN2O, and never pass for the others
+INS B i_FN1T(B f, B x, u32* bc) { POS_UPD;
+  if (q_N(x)) { dec(f); return x; }
+  if (vm_canTailCall(f)) return vm_setTailCall(f, bi_N, x);
+  B r = c1(f, x);
+  dec(f); return r;
+}
+INS B i_FN2T(B w, B f, B x, u32* bc) { POS_UPD;
+  if (q_N(x)) { dec(w); dec(f); return x; }
+  if (vm_canTailCall(f)) return vm_setTailCall(f, w, x);
+  B r = q_N(w)? c1(f, x) : c2(f, w, x);
+  dec(f); return r;
+}
 INS B i_FN1O(B f, B x, u32* bc) { POS_UPD;
   B r = q_N(x)? x : c1(f, x);
   dec(f); return r;
@@ -199,7 +239,7 @@ FORCE_INLINE B gotoNextBodyJIT(Scope* sc, Body* body) {
   u64 ga = blockGivenVars(bl);
   for (u64 i = 0; i < ga; i++) inc(sc->vars[i]);
   Scope* nsc = m_scope(body, sc->psc, body->varAm, ga, sc->vars);
-  return execBodyInplaceI(body, nsc, bl);
+  return execBodyRawI(body, nsc, bl); // a bi_tailCall result is returned from this body too, and run by its caller
 }
 INS B i_SETH1(B s, B x, Scope** pscs, u32* bc, Body* v1) { POS_UPD;
   bool ok = v_seth(pscs, s, x); dec(x); dec(s);
@@ -308,7 +348,7 @@ static OptRes opt(u32* bc0) {
     u8 cact = 0;
     #define L64 ({ u64 r = bc[0] | ((u64)bc[1])<<32; bc+= 2; r; })
     #define S(N,I) SRef N = stk[TSSIZE(stk)-1-(I)];
-    switch (*bc++) { case FN1Ci: case FN1Oi: case FN2Ci: case FN2Oi: fatal("optimization: didn't expect already immediate FN__");
+    switch (bcBase(*bc++)) { case FN1Ci: case FN1Oi: case FN2Ci: case FN2Oi: fatal("optimization: didn't expect already immediate FN__");
       case ADDU: case ADDI: cact = 0; TSADD(stk,SREF(b(L64), pos)); break;
       case POPS: { assert(TSSIZE(actions) > 0);
         u64 asz = TSSIZE(actions);
@@ -435,7 +475,7 @@ static OptRes opt(u32* bc0) {
     #define L64 ({ u64 r = bc[0] | ((u64)bc[1])<<32; bc+= 2; r; })
     u32 ctype = actions[tpos++];
     bool ret = false;
-    u32 v = *bc++;
+    u32 v = bcBase(*bc++); // superinstructions are split back up here, as the JIT does its own fusing
     u64 psz = TSSIZE(rbc);
     #define A64(X) { u64 a64=(X); TSADD(rbc, (u32)a64); TSADD(rbc, a64>>32); }
     switch (ctype) { default: UD;
@@ -478,6 +518,7 @@ static OptRes opt(u32* bc0) {
       case 1: ret = true; goto def2; // return
       case 0: def2:; // do nothing
         TSADDA(rbc, sbc, ebc-sbc);
+        rbc[psz] = v==FN1C|v==FN2C? *sbc : v; // keep quickened calls, as the compiler below makes use of them
     }
     u64 added = TSSIZE(rbc)-psz;
     for (u64 i = 0; i < added; i++) TSADD(roff, sbc-bc0);
@@ -522,7 +563,7 @@ void freeOpt(OptRes o) {
     path_wChars(m_c8vec_0("asm_off"), o); dec(o);
     B s = emptyCVec();
     #define F(X) AFMT("s/%p$/%p   # i_" #X "/;", i_##X, i_##X);
-    F(POPS)F(INC)F(FN1C)F(FN1O)F(FN2C)F(FN2O)F(FN1Oi)F(FN2Oi)F(LST_0)F(LST_p)F(ARMM)F(ARMO)F(DFND_0)F(DFND_1)F(DFND_2)F(MD1C)F(MD2C)F(MD2R)F(TR2D)F(TR3D)F(TR3O)F(NOVAR)F(EXTO)F(EXTU)F(SETN)F(SETU)F(SETM)F(SETC)F(SETH1)F(SETH2)F(PRED1)F(PRED2)F(SETNi)F(SETUi)F(SETMi)F(SETCi)F(SETNv)F(SETUv)F(SETMv)F(SETCv)F(FLDG)F(VFYM)F(ALIM)F(CHKV)F(FAIL)F(RETD)
+    F(POPS)F(INC)F(FN1C)F(FN1O)F(FN2C)F(FN2O)F(FN1B)F(FN2B)F(FN1K)F(FN2K)F(FN1Oi)F(FN2Oi)F(LST_0)F(LST_p)F(ARMM)F(ARMO)F(DFND_0)F(DFND_1)F(DFND_2)F(MD1C)F(MD2C)F(MD2R)F(TR2D)F(TR3D)F(TR3O)F(NOVAR)F(EXTO)F(EXTU)F(SETN)F(SETU)F(SETM)F(SETC)F(SETH1)F(SETH2)F(PRED1)F(PRED2)F(SETNi)F(SETUi)F(SETMi)F(SETCi)F(SETNv)F(SETUv)F(SETMv)F(SETCv)F(FLDG)F(VFYM)F(ALIM)F(CHKV)F(FAIL)F(RETD)
     #undef F
     path_wChars(m_c8vec_0("asm_sed"), s); dec(s);
   }
@@ -646,17 +687,15 @@ Nvm_res m_nvm(Body* body) {
     #define TOPs if (depth) { MOV8mro(r_CS, R_RES, SPOSq(0)); }
     #define LSC(R,D) { if(D) MOV8rmo(R,R_SP,VAR8(pscs,D)); else MOV(R,r_SC); } // TODO return r_SC directly without a pointless mov
     #define INCV(R) INC4mo(R, offsetof(Value,refc)); // ADD4mi(R_A3, 1); CCALL(i_INC);
-    #ifdef __BMI2__ // TODO move to runtime detection maybe
-      #define INCB(R,T,U) IMM(T,0xfffffffffffffull);ADD(T,R);IMM(U,0x7fffffffffffeull);CMP(T,U);{J1(cA,lI);MOVi1l(U,48);BZHI(U,R,U);INCV(U);LBL1(lI);}
-    #else
-      #define INCB(R,T,U) IMM(T,0xfffffffffffffull);ADD(T,R);IMM(U,0x7fffffffffffeull);CMP(T,U);{J1(cA,lI);IMM(U,0xffffffffffffull);AND(U,R);INCV(U);LBL1(lI);}
-    #endif
+    // BZHI is used if the CPU we're running on has it, regardless of what the build targets
+    #define INCB(R,T,U) IMM(T,0xfffffffffffffull);ADD(T,R);IMM(U,0x7fffffffffffeull);CMP(T,U);{J1(cA,lI);if(HAS_BMI2){MOVi1l(U,48);BZHI(U,R,U);}else{IMM(U,0xffffffffffffull);AND(U,R);}INCV(U);LBL1(lI);}
     // #define POS_UPD(R1,R2) IMM(R1, off); MOV8mro(r_ENV, R1, offsetof(Env,pos));
     #define POS_UPD(R1,R2) MOV4moi(r_ENV, offsetof(Env,pos), body->bl->map[bcpos + bodyOff]<<1 | 1);
     #define GS_SET(R) MOV8pr(&gStack, R)
     #define GET(R,P,U) { i32 p = SPOSq(-(P)); if (U && lGPos!=p) { Reg t=LEA0(R,r_CS,p,0); GS_SET(t); lGPos=p; if(U!=2) MOV8rm(R,t); } else if (U!=2) { MOV8rmo(R, r_CS, p); } }
     // use GET(R_A1,0,2); as GS_UPD when there's one argument, and GET(R_A3,-1,2); when there are zero arguments (i think?)
     #define NORES(D) if (depth>D) MOV8rm(R_RES, SPOS(R_A3, -D, 0)); // call at end if rax is unset; arg is removed stack item count
+    bool tail = VM_TAILCALL && *n==RETN && !body->bl->imm;
     switch (*bc++) {
       case POPS: TOPp;
         CCALL(i_POPS);
@@ -665,10 +704,16 @@ Nvm_res m_nvm(Body* body) {
       break;
       case ADDI: TOPs; { u64 x = L64; IMM(R_RES, x); IMM(R_A3, v(b(x))); INCV(R_A3); break; } // (u64 v, S)
       case ADDU: TOPs; IMM(R_RES, L64); break;
-      case FN1C: TOPp;                GET(R_A1,1,1); IMM(R_A2,off); CCALL(i_FN1C); break; // (     B f, B x, u32* bc)
-      case FN1O: TOPp;                GET(R_A1,1,1); IMM(R_A2,off); CCALL(i_FN1O); break; // (     B f, B x, u32* bc)
-      case FN2C: TOPp; GET(R_A1,1,0); GET(R_A2,2,1); IMM(R_A3,off); CCALL(i_FN2C); break; // (B w, B f, B x, u32* bc)
-      case FN2O: TOPp; GET(R_A1,1,0); GET(R_A2,2,1); IMM(R_A3,off); CCALL(i_FN2O); break; // (B w, B f, B x, u32* bc)
+      case FN1C: case FN1M:
+                 TOPp;                GET(R_A1,1,1); IMM(R_A2,off); CCALL(tail? i_FN1T : i_FN1C); break; // (     B f, B x, u32* bc)
+      case FN1B: TOPp;                GET(R_A1,1,1); IMM(R_A2,off); CCALL(i_FN1B); break; // (     B f, B x, u32* bc)
+      case FN1K: TOPp;                GET(R_A1,1,1); IMM(R_A2,off); CCALL(tail? i_FN1T : i_FN1K); break; // (     B f, B x, u32* bc)
+      case FN1O: TOPp;                GET(R_A1,1,1); IMM(R_A2,off); CCALL(tail? i_FN1T : i_FN1O); break; // (     B f, B x, u32* bc)
+      case FN2C: case FN2M:
+                 TOPp; GET(R_A1,1,0); GET(R_A2,2,1); IMM(R_A3,off); CCALL(tail? i_FN2T : i_FN2C); break; // (B w, B f, B x, u32* bc)
+      case FN2B: TOPp; GET(R_A1,1,0); GET(R_A2,2,1); IMM(R_A3,off); CCALL(i_FN2B); break; // (B w, B f, B x, u32* bc)
+      case FN2K: TOPp; GET(R_A1,1,0); GET(R_A2,2,1); IMM(R_A3,off); CCALL(tail? i_FN2T : i_FN2K); break; // (B w, B f, B x, u32* bc)
+      case FN2O: TOPp; GET(R_A1,1,0); GET(R_A2,2,1); IMM(R_A3,off); CCALL(tail? i_FN2T : i_FN2O); break; // (B w, B f, B x, u32* bc)
       case FN1Ci: { u64 fn = L64; POS_UPD(R_A0,R_A3); MOV(R_A1, R_RES); GET(R_A2,0,2); CCALL(fn); } break;
       case FN2Ci: { u64 fn = L64; POS_UPD(R_A0,R_A3); MOV(R_A1, R_RES); GET(R_A2,1,1); CCALL(fn); } break;
       case FN1Oi:TOPp; GET(R_A1,0,2); IMM(R_A1,L64);                 IMM(R_A2,off); CCALL(i_FN1Oi); break; // (     B x, FC1 fm,         u32* bc)
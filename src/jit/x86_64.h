@@ -189,7 +189,7 @@ static const u8 cLE = 0xE; static const u8 cG  = 0xF;
 // MOV8mro: // *(u64*)(nullptr + I + OFF) ← O
 // MOV4rmo: // O ← *(u32*)(nullptr + I + OFF)
 // MOV4mro: // *(u32*)(nullptr + I + OFF) ← O
-// BZHI: requires __BMI2__
+// BZHI: requires BMI2; check HAS_BMI2 before emitting
 ASMI(ADD,  Reg o, Reg i) { ASMS; REX8(o,i); ASM1(0x01); MRMr(o,i); ASME; }
 ASMI(SUB,  Reg o, Reg i) { ASMS; REX8(o,i); ASM1(0x29); MRMr(o,i); ASME; }
 ASMI( OR,  Reg o, Reg i) { ASMS; REX8(o,i); ASM1(0x09); MRMr(o,i); ASME; }
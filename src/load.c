@@ -12,7 +12,7 @@
 #define PRECOMPILED_FILE(END) STR1(../build/BYTECODE_DIR/gen/END)
 
 #define FOR_INIT(F) \
-/* initialize primary things */ F(base) F(harr) F(mutF) F(cmpA) F(fillarr) F(tyarr) F(hash) F(sfns) F(fns) F(arithm) F(arithd) F(md1) F(md2) F(derv) F(comp) F(rtWrap) F(ns) F(nfn) F(sysfn) F(inverse) F(slash) F(search) F(transp) F(ryu) F(ffi) F(mmap) \
+/* initialize primary things */ F(base) F(cpu) F(harr) F(mutF) F(cmpA) F(fillarr) F(strlist) F(tyarr) F(hash) F(sfns) F(fns) F(arithm) F(arithd) F(md1) F(md2) F(derv) F(comp) F(rtWrap) F(ns) F(nfn) F(sysfn) F(inverse) F(slash) F(group) F(search) F(transp) F(ryu) F(ffi) F(mmap) \
 /* first thing that executes BQN code (the precompiled stuff) */ F(load) \
 /* precompiled stuff loaded; init things that need it */ F(sysfnPost) F(dervPost) F(typesFinished)
 
@@ -121,7 +121,7 @@ static NOINLINE B m_blockinfo(ux info, B c, B d) {
   #define assume_separate_storage(A, B)
 #endif
 
-extern Arr* staticSliceRoot;
+extern GLOBAL Arr* staticSliceRoot;
 
 static NOINLINE void init_intarrs(B* dst, const i32* all_data, const u32* lengths, ux n) {
   ptr_incBy(staticSliceRoot, n);
@@ -182,8 +182,31 @@ static void change_def_comp(B comp) { // consumes
 #if NATIVE_COMPILER
 #include "opt/comp.c"
 B load_fullComp;
+#if !ONLY_NATIVE_COMP
+STATIC_GLOBAL B load_autoComp; // native compiler, falling back to the self-hosted one for anything it rejects
+static B autoComp_c2(B t, B w, B x) {
+  if (CATCH) {
+    freeThrown();
+    return c2(load_fullComp, w, x);
+  }
+  B r = nativeComp_c2(bi_N, inc(w), inc(x));
+  popCatch();
+  dec(w); dec(x);
+  return r;
+}
 void switchComp(void) {
-  change_def_comp(harr_ptr(def_re)[re_compFn].u==load_fullComp.u? incG(native_comp) : incG(load_fullComp));
+  change_def_comp(harr_ptr(def_re)[re_compFn].u==load_fullComp.u? incG(load_autoComp) : incG(load_fullComp));
+}
+#endif
+B native_exec(B str, B state) { // consumes; like bqn_exec, but compiles with the native compiler only
+  B* o = harr_ptr(def_re);
+  B prev = inc(o[re_compFn]);
+  change_def_comp(incG(native_comp));
+  if (CATCH) { change_def_comp(prev); rethrow(); }
+  B r = bqn_exec(str, state);
+  popCatch();
+  change_def_comp(prev);
+  return r;
 }
 #endif
 B compObj_c1(B t, B x) {
@@ -282,6 +305,9 @@ void init_comp(B* new_re, B* prev_re, B prim, B sys) {
     new_re[re_rt]       = inc(prev_re[re_rt]);
     new_re[re_glyphs]   = inc(prev_re[re_glyphs]);
   } else {
+    #if ONLY_NATIVE_COMP
+      thrM("•ReBQN: 𝕩.primitives needs the self-hosted compiler, which isn't included with -DONLY_NATIVE_COMP");
+    #endif
     if (!isArr(prim) || RNK(prim)!=1) thrM("•ReBQN: 𝕩.primitives must be a list");
     usz pia = IA(prim);
     usz np[3] = {0}; // number of functions, 1-modifiers, and 2-modifiers
@@ -598,7 +624,9 @@ void load_init() { // very last init function
       
       load_comp = c1(load_compgen, incG(load_glyphs));
       #if NATIVE_COMPILER
-        load_fullComp = load_comp;
+        gc_add(load_fullComp = load_comp);
+        gc_add(load_autoComp = m_nfn(registerNFn(m_c8vec_0("(compiler)"), c1_bad, autoComp_c2), bi_N));
+        load_comp = incG(load_autoComp);
       #endif
     #endif
     HArr_p ps = m_harr0v(re_max);
@@ -665,7 +693,11 @@ B bqn_explain(B str) {
     }
     
     COMPS_PUSH(str, bi_N, def_re);
-    B c = c2(o[re_compFn], incG(o[re_compOpts]), inc(str));
+    #if NATIVE_COMPILER && !ONLY_NATIVE_COMP
+      B c = c2(load_fullComp, incG(o[re_compOpts]), inc(str)); // the explainer needs the self-hosted compiler's token info
+    #else
+      B c = c2(o[re_compFn], incG(o[re_compOpts]), inc(str));
+    #endif
     COMPS_POP;
     B ret = c2(load_explain, c, str);
     return ret;
@@ -894,6 +926,9 @@ void typesFinished_init() {
 GLOBAL bool cbqn_initialized;
 void cbqn_init() {
   if (cbqn_initialized) return;
+  #if HEAP_IMAGE
+    if (heapImage_load()) { cpu_init(); return; } // the image holds the writing machine's CPU flags
+  #endif
   #define F(X) X##_init();
     FOR_INIT(F)
   #undef F
@@ -6,6 +6,8 @@
 #include "utils/talloc.h"
 #include "utils/file.h"
 #include "utils/time.h"
+#include "utils/perf.h"
+#include "utils/cpu.h"
 #include "utils/interrupt.h"
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -69,7 +71,7 @@ static NOINLINE i64 readInt(char** p) {
   #include <errno.h>
   #include "utils/cstr.h"
   GLOBAL Replxx* global_replxx;
-  INIT_GLOBAL bool replxx_read_only = false;
+  static bool replxx_read_only = false; // set from the arguments before cbqn_init, so not in the GLOBAL section a heap image restores
   STATIC_GLOBAL char* global_histfile;
   STATIC_GLOBAL u32 cfg_prefixChar = U'\\';
   
@@ -124,6 +126,7 @@ static NOINLINE i64 readInt(char** p) {
     ")profile ", ")profile@",
     ")t ", ")t:", ")time ", ")time:",
     ")mem", ")mem t", ")mem s", ")mem f", ")mem log",
+    ")perf",
     ")erase ",
     ")clearImportCache",
     ")kb",
@@ -598,6 +601,20 @@ static NOINLINE void printTime(f64 ns) {
   else if (ns<1e9) printf("%.4gms\n", ns/1e6);
   else             printf("%.5gs\n", ns/1e9);
 }
+STATIC_GLOBAL bool cfg_perf; // whether )time also reports performance counters
+static NOINLINE void printPerf(PerfCounts* s, PerfCounts* e, f64 rep) {
+  static char* const descs[PERF_CNT_N] = {"cycles", "instructions", "branch misses", "L1d misses", "LLC misses", "page faults"};
+  PerfCounts d;
+  perf_diff(&d, s, e, rep);
+  bool first = true;
+  for (i32 i = 0; i < PERF_CNT_N; i++) {
+    if (d.c[i]<0) continue;
+    printf("%s%.4g %s", first? "" : ", ", d.c[i], descs[i]);
+    first = false;
+  }
+  if (d.c[pc_cycles]>0 && d.c[pc_instructions]>=0) printf(" (%.3g IPC)", d.c[pc_instructions]/d.c[pc_cycles]);
+  printf("\n");
+}
 static NOINLINE f64 timeBlockN(Block* block, i64 rep) {
   u64 sns = nsTime();
   for (i64 i = 0; i < rep; i++) dec(execBlockInplace(block, gsc));
@@ -682,6 +699,12 @@ void cbqn_runLine0(char* ln, i64 read) {
         heap_printInfoStr(cmdE);
       }
       return;
+    } else if (isCmd(cmdS, &cmdE, "perf ")) {
+      PerfCounts t;
+      if (!cfg_perf && !perf_read(&t)) { printf("Performance counters aren't available\n"); return; }
+      cfg_perf^= true;
+      printf("Performance counters in )time %s\n", cfg_perf? "enabled" : "disabled");
+      return;
     } else if (isCmd(cmdS, &cmdE, "erase ")) {
       char* name = cmdE;
       i64 len = strlen(name);
@@ -825,13 +848,19 @@ void cbqn_runLine0(char* ln, i64 read) {
   gsc->body = ptr_inc(block->bodies[0]);
   
   B res;
+  PerfCounts perfS, perfE;
+  bool perf = cfg_perf && mode>=1 && mode<=3;
+  if (perf) perf_read(&perfS);
   if (mode==1) {
     u64 sns = nsTime();
     res = execBlockInplace(block, gsc);
     u64 ens = nsTime();
+    if (perf) perf_read(&perfE);
     printTime(ens-sns);
+    if (perf) printPerf(&perfS, &perfE, 1);
   } else if (mode==2) {
     printTime(timeBlockN(block, timeRep) / timeRep);
+    if (perf) { perf_read(&perfE); printPerf(&perfS, &perfE, timeRep); }
     res = m_c32(0);
   } else if (mode==3) {
     f64 tns = 0; // total nanoseconds timed
@@ -849,7 +878,9 @@ void cbqn_runLine0(char* ln, i64 read) {
       else if (r2 >= r1*2) { r1*=2; }
       else r1 = r2;
     }
+    if (perf) perf_read(&perfE);
     printTime(tns / rt);
+    if (perf) printPerf(&perfS, &perfE, rt);
   } else if (mode==4 || mode==5) {
     if (CATCH) { profiler_stop(); profiler_free(); rethrow(); }
     if (profiler_alloc() && profiler_start(mode==5? 2 : 1, profile)) {
@@ -947,6 +978,11 @@ int main(int argc, char* argv[]) {
           "  -r         start the REPL after executing all arguments\n"
           "  -s         start a silent REPL\n"
           "  --help     show this help text\n"
+          #if HEAP_IMAGE
+          "  --write-image file  write an image of the initialized interpreter to file, for faster startup;\n"
+          "             loaded from $CBQN_IMAGE or the binary's path with .img appended, and only\n"
+          "             usable by a non-PIE build, or with ASLR disabled (e.g. via setarch -R)\n"
+          #endif
           #if HAS_VERSION
           "  --version  display CBQN version information\n"
           #endif
@@ -958,7 +994,16 @@ int main(int argc, char* argv[]) {
           #else
             printf("CBQN, unknown version\n");
           #endif
+          cpu_init();
+          printf("CPU features: %s\n", cpu_features());
+          exit(0);
+        #if HEAP_IMAGE
+        } else if (!strcmp(carg, "--write-image")) {
+          if (i==argc) { fprintf(stderr, "%s: --write-image requires an argument\n", argv[0]); exit(1); }
+          cbqn_init();
+          heapImage_write(argv[i]);
           exit(0);
+        #endif
         #if USE_REPLXX
         } else if (!strcmp(carg, "--replxx-read-only")) {
           replxx_read_only = true;
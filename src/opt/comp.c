@@ -1,505 +1,990 @@
 #include "../nfns.h"
 #include "../vm.h"
 #include "../ns.h"
-#include "../utils/mut.h"
-// minimal compiler, capable of running mlochbaum/BQN/src/bootstrap/boot2.bqn
-// supports:
-//   parentheses, ⟨…⟩ literals, •-values
-//   non-destructuring variable assignment
-//   function, 1-modifier, and 2-modifier invocation
-//   value and function class variables, namespace .-access
-// input must be either an immediate expression, or a block potentially containing 𝕨 or 𝕩
+#include "../utils/hash.h"
+// native compiler; gives the same ⟨bytecode, objects, blocks, bodies, indices, token info⟩ result as the self-hosted one
+// source is tokenized, parsed into a syntax tree with names left unresolved, and then emitted one block body at a time,
+// after all of that body's definitions are known, so names resolve lexically regardless of where they're defined
+// supports the whole language, including headers, multiple bodies, predicates, destructuring, namespaces, ·, […] and REPL scopes
+// rejected with a "Native compiler:" error, to be compiled by the self-hosted compiler instead:
+//   𝕨 written as the left argument of a header
+//   two header-less bodies without predicates (monadic and dyadic) in a block that also has header-less bodies with predicates
+//   exports (⇐) in a block that isn't an immediate one
+//   redefining a name in a REPL, other than ones from previous REPL lines
+//   invalid code of any kind; error messages don't aim to be as informative as the self-hosted compiler's
 // goal is to either error, or compile correctly
 
 
 B native_comp;
 
-#ifndef FAST_NATIVE_COMP
-  #define FAST_NATIVE_COMP 1
-#endif
-
-
-NOINLINE B nc_emptyI32Vec() {
-  i32* rp;
-  return m_i32arrv(&rp, 0);
-}
-B nc_ivec1(i32 a              ) { i32* rp; B r = m_i32arrv(&rp, 1); rp[0]=a;                   return r; }
-B nc_ivec2(i32 a, i32 b       ) { i32* rp; B r = m_i32arrv(&rp, 2); rp[0]=a; rp[1]=b;          return r; }
-B nc_ivec3(i32 a, i32 b, i32 c) { i32* rp; B r = m_i32arrv(&rp, 3); rp[0]=a; rp[1]=b; rp[2]=c; return r; }
-NOINLINE void nc_iadd(B* w, i32 x) { // consumes x
-  assert(TY(*w)==t_i32arr);
-  *w = vec_add(*w, m_f64(x));
-}
-NOINLINE void nc_ijoin(B* w, B x) { // doesn't consume x
-  assert(TY(*w)==t_i32arr && TI(x,elType)==el_i32);
-  #if FAST_NATIVE_COMP
-    *w = vec_join(*w, incG(x));
-  #else
-    SGetU(x)
-    usz ia = IA(x);
-    for (usz i = 0; i < ia; i++) nc_iadd(w, o2i(GetU(x, i)));
-  #endif
-}
-
-
-
-#define nc_equal equal
-NOINLINE void nc_add(B* w, B x) { // consumes x
-  *w = vec_add(*w, x);
-}
-NOINLINE B nc_pop(B* wp) {
-  B w = *wp;
-  assert(isArr(w) && v(w)->refc==1 && IA(w)>0);
-  B r = IGetU(w, a(w)->ia-1);
-  a(w)->ia--;
-  #if VERIFY_TAIL
-    assert(TY(w) == t_harr);
-    ux start = offsetof(HArr, a) + a(w)->ia * sizeof(B);
-    FINISH_OVERALLOC(a(w), start, start+sizeof(B));
-  #endif
+// growable vectors of compiler state; ones left behind by an error are freed by the next top-level GC, same as compileBlock's TSALLOCs
+static NOINLINE TStack* nv_new(u32 elsz, usz cap) {
+  TStack* r = (TStack*)mm_alloc(sizeof(TStack) + elsz*cap, t_temp);
+  r->size = 0;
+  r->cap = cap;
   return r;
 }
+#define NV_P(T,V) ((T*)(V)->data)
+#define NV_ADD(T,V,X) ({ T x_ = (X); if ((V)->size==(V)->cap) (V) = ts_e(V, sizeof(T), 1); NV_P(T,V)[(V)->size] = x_; (i32)(V)->size++; })
+#define NV_FREE(V) mm_free((Value*)(V))
 
+enum { NT_END, NT_LIT, NT_NAME, NT_SPEC }; // token kinds; other tokens have the syntax character as their kind, with ⋄ and newline as ','
+typedef struct NTok {
+  u32 k;
+  u8 cls;   // 0:function 1:1-modifier 2:2-modifier 3:subject
+  i32 v;    // NT_LIT: index in objs; NT_NAME: index in names; NT_SPEC: index in nc_specials
+  i32 s, e; // source range
+} NTok;
 
+enum {
+  NK_LIT, NK_NAME, NK_SPEC, NK_NOTHING, NK_BLOCK, // a: object, name, special, -, block index
+  NK_LIST, NK_ARR,             // ⟨…⟩ or strand, […]; a: start in kids, b: count
+  NK_FIELD,                    // a.b; a: namespace, b: name
+  NK_CALL1, NK_CALL2,          // a: f, b: x; a: w, b: f, c: x
+  NK_MD1, NK_MD2,              // a: f, b: m; a: f, b: m, c: g
+  NK_ATOP, NK_FORK,            // a: g, b: h; a: f, b: g, c: h
+  NK_SET,                      // a: target, b: value, x: 0 for ←, 1 for ↩, 2 for ⇐
+  NK_SETM,                     // a F↩ x; a: target, b: F, c: x or -1
+  NK_EXPORT,                   // a⇐ with no value; a: target
+  NK_PRED,                     // a?; a: condition
+};
+typedef struct NNode {
+  u8 k, cls, x;
+  i32 a, b, c;
+  i32 s, e;
+} NNode;
 
-NOINLINE B nc_literal(B val) {
-  HArr_p r = m_harr0p(1);
-  r.a[0] = val;
-  arr_shAtm((Arr*)r.c);
-  return r.b;
-}
+enum { HK_NONE, HK_LABEL, HK_MON, HK_DY, HK_INVM, HK_INVX, HK_INVW }; // header kinds; HK_INVX is 𝕨F⁼𝕩, HK_INVW is 𝕨F˜⁼𝕩
+typedef struct NBody {
+  u8 hk, hty; // header kind, and the block type it implies
+  bool pred;
+  i32 hdr, hdrN; // header assignments, as ⟨special, pattern⟩ pairs in kids
+  i32 st, stN;   // statements in kids
+  u8 lists;      // bit mask of the body lists this body goes in, in compileBlock's order
+  i32 idx;       // index in the result's bodies
+} NBody;
+typedef struct NBlock {
+  u8 uses; // 1: 𝕨𝕩𝕤 used; 2: 𝕗 or _𝕣 used; 4: 𝕘 or _𝕣_ used
+  u8 ty;
+  bool imm;
+  i32 body, bodyN; // range in bodies
+  i32 parent;      // scope the block is in, set when it's emitted
+} NBlock;
+typedef struct NScope { // variables of a block body; ones of a body are contiguous in vars, as all are defined before any other body is emitted
+  i32 parent;
+  i32 v0, vN;
+  u8 sStart; // specials 𝕤𝕩𝕨𝕣𝕗𝕘 starting at this index are the first variables
+  bool ns;   // has exports
+} NScope;
+typedef struct NVar {
+  i32 name; // -1 for specials
+  bool exported, loose; // loose: defined by a previous REPL line, so it can be redefined
+} NVar;
+typedef struct NOutBody { i32 start, scope; } NOutBody;
+
+typedef struct NComp {
+  u32* src; // source, followed by two 0s
+  TStack* toks; i32 ti; // tokens, and the current position in them
+  TStack* nodes;
+  TStack* kids; // child lists of nodes, bodies, and headers
+  TStack* bodies;
+  TStack* blocks; // block 0 is the whole program
+  TStack* scopes;
+  TStack* vars;
+  TStack* queue;   // blocks to emit
+  TStack* out;     // NOutBody for each body in the result
+  TStack *bc, *bs, *be; // bytecode, and the source range of each of its elements
+  i32 cb; // block being parsed
+  B objs;  // constants
+  B names; // nameList
+  H_b2i* nameMap; // name → index in names
+  B prims, sys;
+  i32 primObj[64];
+} NComp;
+
+#define TK (NV_P(NTok, c->toks)[c->ti])
+#define NN(I) (NV_P(NNode, c->nodes)+(I))
+static u32* nc_specials = U"𝕤𝕩𝕨𝕣𝕗𝕘"; // in the order the VM expects them
+
+
+
+// tokenizer
 static bool nc_up(u32 c) { return (c>='A' & c<='Z'); }
 static bool nc_al(u32 c) { return (c>='a' & c<='z') | nc_up(c); }
 static bool nc_num(u32 c) { return (c>='0' & c<='9'); }
-B sys_c1(B, B);
-NOINLINE B nc_tokenize(B prims, B sysvs, u32* chars, usz len, bool* hasBlock) {
-  B r = emptyHVec();
+static bool nc_nameCh(u32 c) { return nc_al(c) | nc_num(c) | (c=='_') | (c==U'¯') | (c==U'π') | (c==U'∞'); }
+
+static NOINLINE i32 nc_addObj(NComp* c, B v) { // consumes v
+  c->objs = vec_addN(c->objs, v);
+  return IA(c->objs)-1;
+}
+static NOINLINE i32 nc_nameId(NComp* c, B name) { // consumes name
+  bool had;
+  u64 p = mk_b2i(&c->nameMap, name, &had);
+  if (had) { decG(name); return c->nameMap->a[p].val; }
+  i32 r = IA(c->names);
+  c->names = vec_addN(c->names, name);
+  c->nameMap->a[p].val = r;
+  return r;
+}
+static NOINLINE f64 nc_number(u32* s, usz* ip) { // parses the digits of a number literal at s+*ip, not including a leading ¯
+  usz i = *ip;
+  char buf[400];
+  usz bl = 0;
+  #define NUM_ADD(C) ({ if (bl >= sizeof(buf)-1) thrM("Native compiler: Number literal too long"); buf[bl++] = (C); })
+  #define DIGITS ({ while (nc_num(s[i]) || (s[i]=='_' && bl>0)) { if (s[i]!='_') NUM_ADD(s[i]); i++; } })
+  DIGITS;
+  if (s[i]=='.' && nc_num(s[i+1])) { NUM_ADD('.'); i++; DIGITS; }
+  if ((s[i]=='e' | s[i]=='E') && (nc_num(s[i+1]) || (s[i+1]==U'¯' && nc_num(s[i+2])))) {
+    NUM_ADD('e'); i++;
+    if (s[i]==U'¯') { NUM_ADD('-'); i++; }
+    DIGITS;
+  }
+  #undef DIGITS
+  #undef NUM_ADD
+  if (nc_nameCh(s[i])) thrM("Native compiler: Letter directly after a number");
+  buf[bl] = 0;
+  *ip = i;
+  return strtod(buf, NULL);
+}
+static u8 nc_nameCls(u32* s, usz i0, usz i1) { // role of the name spelled by s[i0…i1)
+  if (s[i0]=='_') return s[i1-1]=='_' && i1-i0>1? 2 : 1;
+  return nc_up(s[i0])? 0 : 3;
+}
+static NOINLINE B nc_normName(u32* s, usz i0, usz i1) { // lowercase, without underscores
+  usz ia = 0;
+  for (usz j = i0; j < i1; j++) ia+= s[j]!='_';
+  if (ia==0) thrM("Native compiler: Invalid name");
+  u32* np; B r = m_c32arrv(&np, ia);
+  usz k = 0;
+  for (usz j = i0; j < i1; j++) if (s[j]!='_') np[k++] = s[j] + (nc_up(s[j])? 32 : 0);
+  return r;
+}
+
+static NOINLINE void nc_tokenize(NComp* c, usz len) {
+  u32* s = c->src;
   usz i = 0;
-  usz pi = USZ_MAX;
-  while (i < len) {
-    u32 c = chars[i++];
-    if (i==pi) thrF("Native compiler: Tokenizer stuck on \\u%xi / %i", c, c);
-    B val;
-    switch (c) {
-      case U'∞': val = nc_literal(m_f64(1.0/0)); break;
-      case U'π': val = nc_literal(m_f64(3.141592653589793)); break;
-      case '@': val = nc_literal(m_c32(0)); break;
-      case ' ': continue;
-      case'0'...'9': case U'¯': { // numbers
-        bool neg = c==U'¯';
-        if (!neg) i--;
-        else if (!nc_num(chars[i])) thrM("Native compiler: Standalone negative sign");
-        f64 num = 0;
-        while (nc_num(chars[i])) num = num*10 + (chars[i++]-'0');
-        if (neg) num = -num;
-        val = nc_literal(m_f64(num));
+  while (true) {
+    NTok t = {.s = i};
+    if (i >= len) { t.k = NT_END; t.e = i; NV_ADD(NTok, c->toks, t); break; }
+    u32 ch = s[i++];
+    switch (ch) {
+      case ' ': case '\t': case '\r': continue;
+      case '#': while (i<len && s[i]!='\n') i++; continue;
+      case U'⋄': case ',': case '\n': t.k = ','; break;
+      case '(': case ')': case '{': case '}': case U'⟨': case U'⟩': case '[': case ']':
+      case U'←': case U'↩': case U'⇐': case '.': case U'‿': case U'·': case ':': case ';': case '?':
+        t.k = ch; break;
+      case '@': t.k = NT_LIT; t.cls = 3; t.v = nc_addObj(c, m_c32(0)); break;
+      case '0'...'9': case U'¯': case U'∞': case U'π': { // numbers
+        bool neg = ch==U'¯';
+        u32 d = neg? s[i++] : ch;
+        f64 num;
+        if (d==U'∞') num = 1.0/0.0;
+        else if (d==U'π') num = 3.141592653589793;
+        else if (nc_num(d)) { i--; num = nc_number(s, &i); }
+        else thrM("Native compiler: Standalone negative sign");
+        t.k = NT_LIT; t.cls = 3; t.v = nc_addObj(c, m_f64(neg? -num : num));
         break;
       }
       case '"': { // string literal
         usz i0 = i;
-        while ('"'!=chars[i]) { i++; if (i>=len) thrM("Native compiler: Unclosed string literal"); }
-        if (chars[i+1]=='"') thrM("Native compiler: No support for escaped quote characters in strings");
-        usz ia = i-i0;
-        u32* vp; val = nc_literal(m_c32arrv(&vp, ia));
-        memcpy(vp, chars+i0, ia*sizeof(u32));
+        usz ia = 0;
+        while (true) {
+          if (i>=len) thrM("Native compiler: Unclosed string literal");
+          if ('"'==s[i]) { if ('"'!=s[i+1]) break; i++; }
+          i++; ia++;
+        }
+        u32* vp; B val = m_c32arrv(&vp, ia);
+        usz j = i0;
+        for (usz k = 0; k < ia; k++) { vp[k] = s[j]; j+= '"'==s[j]? 2 : 1; }
         i++;
+        t.k = NT_LIT; t.cls = 3; t.v = nc_addObj(c, val);
         break;
       }
       case '\'': { // character literal
-        if (i+1 >= len || chars[i+1] != '\'') thrM("Native compiler: Unclosed character literal");
-        val = nc_literal(m_c32(chars[i]));
+        if (i+1 >= len || s[i+1] != '\'') thrM("Native compiler: Unclosed character literal");
+        t.k = NT_LIT; t.cls = 3; t.v = nc_addObj(c, m_c32(s[i]));
         i+= 2;
         break;
       }
-      case '#': { // comments
-        while (i<len && chars[i]!='\n') i++;
-        val = m_c32(','); i++;
-        break;
-      }
-      case U'𝕨': case U'𝕩': { // special names
-        *hasBlock = true;
-        val = m_hvec2(m_f64(3), m_c32vec((u32[1]){c}, 1));
+      case U'𝕨': case U'𝕩': case U'𝕤': case U'𝕗': case U'𝕘': t.cls = 3; goto special;
+      case U'𝕎': case U'𝕏': case U'𝕊': case U'𝔽': case U'𝔾': t.cls = 0; goto special;
+      special: {
+        u32 l = ch==U'𝕎'? U'𝕨' : ch==U'𝕏'? U'𝕩' : ch==U'𝕊'? U'𝕤' : ch==U'𝔽'? U'𝕗' : ch==U'𝔾'? U'𝕘' : ch;
+        t.k = NT_SPEC;
+        t.v = 0;
+        while (nc_specials[t.v]!=l) t.v++;
         break;
       }
-      case 'a'...'z': case 'A'...'Z': case U'•': { // names
-        bool sys = c==U'•';
-        usz i0 = sys? i : i-1;
-        while (nc_al(chars[i]) | nc_num(chars[i])) i++;
-        usz ia = i-i0;
-        u32* np; B name = m_c32arrv(&np, ia);
-        PLAINLOOP for (usz j = 0; j < ia; j++) np[j] = chars[i0+j] + (nc_up(chars[i0+j])? 32 : 0);
-        if (sys) {
-          B sysRes = C1(sys, m_hvec1(name));
-          val = nc_literal(IGet(sysRes, 0)); // won't have the class the user entered but ¯\_(ツ)_/¯
-          decG(sysRes);
-        } else {
-          val = m_hvec2(m_f64(nc_up(c)? 0 : 3), name);
+      case U'𝕣': thrM("Native compiler: 𝕣 can only be used as _𝕣 or _𝕣_");
+      case 'a'...'z': case 'A'...'Z': case '_': { // names
+        if (ch=='_' && s[i]==U'𝕣') { // _𝕣 and _𝕣_
+          i++;
+          bool two = s[i]=='_';
+          if (two) i++;
+          t.k = NT_SPEC; t.cls = two? 2 : 1; t.v = 3;
+          break;
         }
+        usz i0 = i-1;
+        while (nc_nameCh(s[i])) i++;
+        t.k = NT_NAME; t.cls = nc_nameCls(s, i0, i);
+        t.v = nc_nameId(c, nc_normName(s, i0, i));
         break;
       }
-      case U'⋄': case ',': case '\n': { // separators
-        val = m_c32(',');
-        break;
-      }
-      case '(': case ')': case '{': case '}': case U'⟨': case U'⟩': case U'←': case U'↩': case U'.': { // syntax to be parsed later
-        val = m_c32(c);
+      case U'•': { // system values
+        usz i0 = i;
+        while (nc_nameCh(s[i])) i++;
+        if (i==i0 || nc_num(s[i0])) thrM("Native compiler: Invalid system value name");
+        B sysRes = c1(c->sys, m_hvec1(nc_normName(s, i0, i)));
+        t.k = NT_LIT; t.cls = nc_nameCls(s, i0, i); t.v = nc_addObj(c, IGet(sysRes, 0));
+        decG(sysRes);
         break;
       }
       default: { // primitives
         u32* primRepr = U"+-×÷⋆√⌊⌈|¬∧∨<>≠=≤≥≡≢⊣⊢⥊∾≍⋈↑↓↕«»⌽⍉/⍋⍒⊏⊑⊐⊒∊⍷⊔!˙˜˘¨⌜⁼´˝`∘○⊸⟜⌾⊘◶⎉⚇⍟⎊";
         usz j = 0;
-        while(primRepr[j]) {
-          if (primRepr[j]==c) { val = nc_literal(IGet(prims, j)); goto add; }
-          j++;
-        }
-        thrF("Native compiler: Can't tokenize \\u%xi / %i", c, c);
+        while (primRepr[j] && primRepr[j]!=ch) j++;
+        if (!primRepr[j]) thrF("Native compiler: Can't tokenize \\u%xi / %i", ch, ch);
+        if (c->primObj[j]<0) c->primObj[j] = nc_addObj(c, IGet(c->prims, j));
+        B p = IGetU(c->objs, c->primObj[j]);
+        t.k = NT_LIT; t.cls = isFun(p)? 0 : isMd1(p)? 1 : 2; t.v = c->primObj[j];
+        break;
       }
     }
-    add:
-    nc_add(&r, val);
+    t.e = i;
+    NV_ADD(NTok, c->toks, t);
   }
+}
+
+
+
+// parser
+static NOINLINE i32 nc_node(NComp* c, u8 k, u8 cls, i32 a, i32 b, i32 cc, u8 x, i32 s, i32 e) {
+  return NV_ADD(NNode, c->nodes, ((NNode){.k=k, .cls=cls, .x=x, .a=a, .b=b, .c=cc, .s=s, .e=e}));
+}
+static NOINLINE i32 nc_kids(NComp* c, TStack* l) { // consumes l; moves it to kids, returning where it starts
+  i32 r = c->kids->size;
+  for (usz i = 0; i < l->size; i++) NV_ADD(i32, c->kids, NV_P(i32,l)[i]);
+  NV_FREE(l);
   return r;
 }
+static i32 nc_kid(NComp* c, i32 i) { return NV_P(i32, c->kids)[i]; }
+static NORETURN NOINLINE void nc_unexpected(NComp* c) {
+  u32 k = TK.k;
+  if (k==NT_END) thrM("Native compiler: Unexpected end of source");
+  if (k>NT_SPEC) thrF("Native compiler: Unexpected '%c'", k);
+  thrM("Native compiler: Unexpected token");
+}
+static void nc_expect(NComp* c, u32 k) {
+  if (TK.k!=k) nc_unexpected(c);
+  c->ti++;
+}
+static void nc_skipSeps(NComp* c) {
+  while (TK.k==',') c->ti++;
+}
 
-usz addObj(B* objs, B val) { // consumes val
-  nc_add(objs, val);
-  return IA(*objs)-1;
-}
-
-i32 nc_ty(B x) { return o2iG(IGetU(x, 0)); }
-
-B nc_generate(B p1) { // consumes
-  // printf("p1: "); printI(p1); printf("\n");
-  
-  usz p1ia = IA(p1);
-  B listFinal;
-  if (p1ia == 1) { // simple case of 1 element
-    listFinal = p1;
-    toFinal:;
-    B elFinal = IGet(listFinal, 0);
-    if(nc_ty(elFinal)>3) thrM("Native compiler: Unexpected assignment");
-    decG(listFinal);
-    return elFinal;
-  }
-  
-  // merge 1-modifiers
-  SGetU(p1)
-  B p2 = emptyHVec();
-  {
-    usz i = 0;
-    while (i < p1ia) {
-      B e = incG(GetU(p1, i));
-      u8 e0t = nc_ty(e);
-      usz j = i+1;
-      if (e0t==4 || e0t==5) goto add;
-      if (!(e0t==0 || e0t==3)) thrM("Native compiler: Unexpected type in expression");
-      while (j<p1ia) {
-        B e1 = GetU(p1, j);
-        u8 e1t = nc_ty(e1);
-        if (e1t==1) {
-          B bc = nc_emptyI32Vec();
-          nc_ijoin(&bc, IGetU(e1, 1));
-          nc_ijoin(&bc, IGetU(e,  1));
-          nc_iadd(&bc, MD1C);
-          decG(e);
-          e = m_hvec2(m_f64(0), bc);
-        } else if (e1t==2) {
-          if (j+1 == p1ia) thrM("Native compiler: Expression ended in 2-modifier");
-          B e2 = GetU(p1, ++j);
-          u8 e2t = nc_ty(e2);
-          if (!(e2t==0 || e2t==3)) thrM("Native compiler: Improper 2-modifier e2 operand");
-          B bc = nc_emptyI32Vec();
-          nc_ijoin(&bc, IGetU(e2, 1));
-          nc_ijoin(&bc, IGetU(e1, 1));
-          nc_ijoin(&bc, IGetU(e,  1));
-          nc_iadd(&bc, MD2C);
-          decG(e);
-          e = m_hvec2(m_f64(0), bc);
-        } else break;
-        j++;
+static i32 nc_expr(NComp* c);
+static i32 nc_block(NComp* c);
+static NOINLINE i32 nc_list(NComp* c, u8 k, u32 close) { // ⟨…⟩ or […], after the opening bracket
+  i32 s = NV_P(NTok, c->toks)[c->ti-1].s;
+  TStack* l = nv_new(sizeof(i32), 4);
+  while (true) {
+    nc_skipSeps(c);
+    if (TK.k==close) break;
+    i32 e = nc_expr(c);
+    if (e<0) nc_unexpected(c);
+    NV_ADD(i32, l, e);
+    if (TK.k!=',' && TK.k!=close) nc_unexpected(c);
+  }
+  i32 n = l->size;
+  if (k==NK_ARR && n==0) thrM("Native compiler: Empty array notation");
+  i32 e = TK.e; c->ti++;
+  return nc_node(c, k, 3, nc_kids(c, l), n, 0, 0, s, e);
+}
+static NOINLINE i32 nc_primary(NComp* c) { // a single term with any field accesses; -1 if there isn't one
+  NTok t = TK;
+  i32 r;
+  switch (t.k) {
+    default: return -1;
+    case NT_LIT:  c->ti++; r = nc_node(c, NK_LIT,  t.cls, t.v, 0, 0, 0, t.s, t.e); break;
+    case NT_NAME: c->ti++; r = nc_node(c, NK_NAME, t.cls, t.v, 0, 0, 0, t.s, t.e); break;
+    case NT_SPEC: c->ti++;
+      NV_P(NBlock, c->blocks)[c->cb].uses|= t.v<3? 1 : t.v==5 || t.cls==2? 4 : 2;
+      r = nc_node(c, NK_SPEC, t.cls, t.v, 0, 0, 0, t.s, t.e);
+      break;
+    case U'·': c->ti++; r = nc_node(c, NK_NOTHING, 3, 0, 0, 0, 0, t.s, t.e); break;
+    case '(': c->ti++;
+      r = nc_expr(c);
+      if (r<0) nc_unexpected(c);
+      nc_expect(c, ')');
+      break;
+    case U'⟨': c->ti++; r = nc_list(c, NK_LIST, U'⟩'); break;
+    case '[':  c->ti++; r = nc_list(c, NK_ARR, ']'); break;
+    case '{':  c->ti++; r = nc_block(c); break;
+  }
+  while (TK.k=='.') {
+    c->ti++;
+    NTok f = TK;
+    if (f.k!=NT_NAME) thrM("Native compiler: Expected a name after '.'");
+    if (NN(r)->cls!=3) thrM("Native compiler: Field access of a non-subject");
+    c->ti++;
+    r = nc_node(c, NK_FIELD, f.cls, r, f.v, 0, 0, t.s, f.e);
+  }
+  return r;
+}
+static NOINLINE i32 nc_atom(NComp* c) { // nc_primary, or a‿b‿c
+  i32 a = nc_primary(c);
+  if (a<0 || TK.k!=U'‿') return a;
+  TStack* l = nv_new(sizeof(i32), 4);
+  NV_ADD(i32, l, a);
+  while (TK.k==U'‿') {
+    c->ti++;
+    i32 e = nc_primary(c);
+    if (e<0) thrM("Native compiler: Strand missing an element");
+    NV_ADD(i32, l, e);
+  }
+  i32 n = l->size;
+  i32 s = NN(a)->s, e = NN(NV_P(i32,l)[n-1])->e;
+  return nc_node(c, NK_LIST, 3, nc_kids(c, l), n, 0, 0, s, e);
+}
+
+static bool nc_op(NComp* c, i32 n) { u8 cl = NN(n)->cls; return cl==0 || cl==3; } // can be an operand or argument
+static NOINLINE TStack* nc_bindMods(NComp* c, TStack* R) { // consumes R; applies modifiers to their operands
+  i32* r = NV_P(i32, R);
+  usz n = R->size;
+  TStack* o = nv_new(sizeof(i32), n);
+  for (usz i = 0; i < n; i++) {
+    i32 t = r[i];
+    u8 tc = NN(t)->cls;
+    usz on = o->size;
+    i32 last = on? NV_P(i32,o)[on-1] : -1;
+    if ((tc==1 || tc==2) && last>=0 && nc_op(c, last)) {
+      i32 m;
+      if (tc==1) {
+        m = nc_node(c, NK_MD1, 0, last, t, 0, 0, NN(last)->s, NN(t)->e);
+      } else {
+        if (i+1 == n) thrM("Native compiler: 2-modifier without a right operand");
+        i32 g = r[++i];
+        if (!nc_op(c, g)) thrM("Native compiler: Improper right operand of a 2-modifier");
+        m = nc_node(c, NK_MD2, 0, last, t, g, 0, NN(last)->s, NN(g)->e);
       }
-      
-      add: nc_add(&p2, e);
-      i = j;
-    }
+      NV_P(i32,o)[on-1] = m;
+    } else NV_ADD(i32, o, t);
   }
-  decG(p1);
-  // printf("p2: "); printI(p2); printf("\n");
-  
-  // parse as either tacit or explicit
-  SGetU(p2)
-  usz p2ia = IA(p2);
-  if (p2ia==1) { listFinal=p2; goto toFinal; }
-  B e = incG(GetU(p2, p2ia-1));
-  usz i = p2ia-1; // pointer to last used thing
-  u8 tyE = nc_ty(GetU(p2,p2ia-1));
-  bool explicit = tyE==3;
-  
-  while(i>0) {
-    B en1 = GetU(p2, i-1);
-    u8 en1t = nc_ty(en1);
-    // printf("e @ %d: ", i); printI(e); printf("\n");
-    
-    if (en1t==4 || en1t==5) { // assignment
-      if (!explicit && i!=1) thrM("Native compiler: Assignment in the middle of tacit code");
-      B bc = nc_emptyI32Vec();
-      nc_ijoin(&bc, IGetU(e,   1));
-      nc_ijoin(&bc, IGetU(en1, 1));
-      if (tyE != o2iG(IGetU(en1, 2))) thrM("Native compiler: Wrong assignment class");
-      nc_iadd(&bc, en1t==4? SETN : SETU);
-      decG(e);
-      e = m_hvec2(m_f64(explicit? 3 : 0), bc);
+  NV_FREE(R);
+  return o;
+}
+static NOINLINE i32 nc_build(NComp* c, TStack* R) { // consumes R; builds an expression from its terms
+  R = nc_bindMods(c, R);
+  i32* r = NV_P(i32, R);
+  i32 i = R->size-1;
+  i32 v = r[i];
+  u8 vc = NN(v)->cls;
+  if (i>0 && vc!=0 && vc!=3) thrM("Native compiler: Unexpected modifier");
+  while (i>0) {
+    i32 f = r[i-1];
+    if (NN(f)->cls!=0) thrM(vc==3? "Native compiler: Expected a function" : "Native compiler: Expected a function in a train");
+    i32 s = NN(f)->s;
+    if (i>=2 && (vc==3? NN(r[i-2])->cls==3 : nc_op(c, r[i-2]))) {
+      i32 w = r[i-2];
+      v = nc_node(c, vc==3? NK_CALL2 : NK_FORK, vc, w, f, v, 0, NN(w)->s, NN(v)->e);
+      i-= 2;
+    } else {
+      v = nc_node(c, vc==3? NK_CALL1 : NK_ATOP, vc, f, v, 0, 0, s, NN(v)->e);
       i-= 1;
+    }
+  }
+  NV_FREE(R);
+  return v;
+}
+static NOINLINE bool nc_isLhs(NComp* c, i32 n) {
+  NNode t = *NN(n);
+  if (t.k==NK_NAME) return true;
+  if (t.k!=NK_LIST && t.k!=NK_ARR) return false;
+  for (i32 i = 0; i < t.b; i++) {
+    i32 e = nc_kid(c, t.a+i);
+    NNode et = *NN(e);
+    if (et.k==NK_NOTHING) continue;
+    if (et.k==NK_SET && et.x==2) { // alias
+      if (!nc_isLhs(c, et.a) || NN(et.b)->k!=NK_NAME) return false;
       continue;
     }
-    if (en1t!=0) thrM("Native compiler: Expected but didn't get function");
-    
-    if (i>=2) { // dyadic call, fork
-      B en2 = GetU(p2, i-2);
-      if (nc_ty(en2)==3 || (!explicit && nc_ty(en2)==0)) {
-        B bc = nc_emptyI32Vec();
-        nc_ijoin(&bc, IGetU(e,   1));
-        nc_ijoin(&bc, IGetU(en1, 1));
-        nc_ijoin(&bc, IGetU(en2, 1));
-        nc_iadd(&bc, explicit? FN2O : TR3O);
-        decG(e);
-        e = m_hvec2(m_f64(explicit? 3 : 0), bc);
-        i-= 2;
-        continue;
+    if (!nc_isLhs(c, e)) return false;
+  }
+  return true;
+}
+static NOINLINE i32 nc_expr(NComp* c) { // parses up to a separator or closing bracket; -1 if there's no expression there
+  TStack* R = nv_new(sizeof(i32), 8);
+  while (true) {
+    u32 k = TK.k;
+    if (k==U'←' || k==U'↩' || k==U'⇐') {
+      R = nc_bindMods(c, R);
+      i32 n = R->size;
+      if (n==0) thrM("Native compiler: Assignment without a target");
+      c->ti++;
+      i32* r = NV_P(i32, R);
+      i32 tgt = r[n-1], fn = -1;
+      if (k==U'↩' && NN(tgt)->cls==0 && n>=2 && NN(r[n-2])->cls==3 && nc_isLhs(c, r[n-2])) { fn = tgt; tgt = r[n-2]; R->size-= 2; }
+      else R->size-= 1;
+      if (!nc_isLhs(c, tgt)) thrM("Native compiler: Invalid assignment target");
+      i32 v = nc_expr(c);
+      i32 s = NN(tgt)->s, e = v>=0? NN(v)->e : NN(fn>=0? fn : tgt)->e;
+      i32 a;
+      if (fn>=0) {
+        if (NN(tgt)->cls!=3 || (v>=0 && NN(v)->cls!=3)) thrM("Native compiler: Modified assignment must be on subjects");
+        a = nc_node(c, NK_SETM, 3, tgt, fn, v, 0, s, e);
+      } else if (v<0) {
+        if (k!=U'⇐') thrM("Native compiler: Assignment without a value");
+        a = nc_node(c, NK_EXPORT, 3, tgt, 0, 0, 0, s, e);
+      } else {
+        u8 vc = NN(v)->cls;
+        if (NN(tgt)->k==NK_NAME? NN(tgt)->cls!=vc : vc!=3) thrM("Native compiler: Role of the two sides in assignment must match");
+        a = nc_node(c, NK_SET, vc, tgt, v, 0, k==U'←'? 0 : k==U'↩'? 1 : 2, s, e);
       }
+      NV_ADD(i32, R, a);
+      break;
+    }
+    i32 a = nc_atom(c);
+    if (a<0) break;
+    NV_ADD(i32, R, a);
+  }
+  if (R->size==0) { NV_FREE(R); return -1; }
+  return nc_build(c, R);
+}
+
+static NOINLINE bool nc_isHeader(NComp* c) { // whether the body at the current token starts with a header
+  i32 depth = 0;
+  for (i32 i = c->ti; ; i++) {
+    u32 k = NV_P(NTok, c->toks)[i].k;
+    switch (k) {
+      case NT_END: return false;
+      case '(': case U'⟨': case '[': case '{': depth++; break;
+      case ')': case U'⟩': case ']': case '}': if (depth-- == 0) return false; break;
+      case ':': if (depth==0) return true; break;
+      case ',': case ';': case '?': case U'←': case U'↩': case U'⇐': if (depth==0) return false; break;
     }
-    
-    // monadic call, atop
-    B bc = nc_emptyI32Vec();
-    nc_ijoin(&bc, IGetU(e,   1));
-    nc_ijoin(&bc, IGetU(en1, 1));
-    nc_iadd(&bc, explicit? FN1O : TR2D);
-    decG(e);
-    e = m_hvec2(m_f64(explicit? 3 : 0), bc);
-    i-= 1;
-  }
-  // printf("e: "); printI(e); printf("\n");
-  decG(p2);
-  return e;
-}
-
-#if FAST_NATIVE_COMP
-  #include "../utils/hash.h"
-  typedef H_b2i** Vars;
-  u32 nc_var(Vars vars, B name) { // doesn't consume
-    bool had;
-    u64 p = mk_b2i(vars, name, &had);
-    if (had) return (*vars)->a[p].val;
-    return (*vars)->a[p].val = (*vars)->pop-1;
-  }
-#else
-  typedef B* Vars;
-  u32 nc_var(Vars vars, B name) { // doesn't consume
-    B o = *vars;
-    usz ia = IA(o);
-    SGetU(o)
-    for (usz i = 0; i < ia; i++) if (nc_equal(GetU(o, i), name)) return i;
-    nc_add(vars, incG(name));
-    return ia;
-  }
-#endif
-
-B nc_parseStatements(B tokens, usz i0, usz* i1, u32 close, B* objs, Vars vars) {
-  SGetU(tokens)
-  usz tia = IA(tokens);
-  usz i = i0;
-  
-  B statements = emptyHVec();
-  B parts = emptyHVec(); // list of lists; first element indicates class: 0:fn; 1:md1; 2:md2; 3:subject; 4:v←; 5:v↩
-  
+  }
+}
+static bool nc_isPrim(NComp* c, i32 n, u32 ch) { return NN(n)->k==NK_LIT && c->src[NN(n)->s]==ch; }
+static NOINLINE bool nc_isPattern(NComp* c, i32 n) { // lhs, possibly with constants to match
+  NNode t = *NN(n);
+  if (t.k==NK_NAME || t.k==NK_LIT) return true;
+  if (t.k!=NK_LIST && t.k!=NK_ARR) return false;
+  for (i32 i = 0; i < t.b; i++) {
+    i32 e = nc_kid(c, t.a+i);
+    if (NN(e)->k!=NK_NOTHING && !nc_isPattern(c, e) && !nc_isLhs(c, e)) return false;
+  }
+  return true;
+}
+static NOINLINE void nc_header(NComp* c, NBody* b) { // parses a header, up to and including its ':'
+  TStack* T = nv_new(sizeof(i32), 4);
+  while (TK.k!=':') {
+    i32 a = nc_atom(c);
+    if (a<0) nc_unexpected(c);
+    NV_ADD(i32, T, a);
+  }
+  c->ti++;
+  i32* t = NV_P(i32, T);
+  i32 n = T->size;
+  i32 k = -1; // the function or modifier being defined
+  for (i32 i = 0; i < n; i++) if (NN(t[i])->k==NK_NAME || NN(t[i])->k==NK_SPEC) {
+    u8 cl = NN(t[i])->cls;
+    if (cl==1 || cl==2) { k = i; break; }
+    if (cl==0 && k<0) k = i;
+  }
+  TStack* H = nv_new(sizeof(i32), 8);
+  #define BIND(S, P) ({ i32 p_ = (P); if (NN(p_)->k==NK_SPEC) { if (NN(p_)->a!=(S)) thrM("Native compiler: Special name in the wrong place in a header"); } else { if (!nc_isPattern(c, p_)) thrM("Native compiler: Invalid header"); NV_ADD(i32, H, S); NV_ADD(i32, H, p_); } })
+  if (k<0) { // just a pattern for 𝕩
+    if (n!=1) thrM("Native compiler: Invalid header");
+    b->hk = HK_MON; b->hty = 0;
+    BIND(1, t[0]);
+  } else {
+    u8 ty = NN(t[k])->cls;
+    i32 i0 = k, i1 = k;
+    if (ty!=0) {
+      i0 = k-1;
+      if (ty==2) i1 = k+1;
+      if (i0<0 || i1>=n) thrM("Native compiler: Missing operand in a header");
+    }
+    i32 j = i1+1;
+    bool swap = j<n && nc_isPrim(c, t[j], U'˜'); if (swap) j++;
+    bool undo = j<n && nc_isPrim(c, t[j], U'⁼'); if (undo) j++;
+    i32 x = j<n? t[j++] : -1;
+    i32 w = i0>0? t[i0-1] : -1;
+    if (j<n || i0>1 || (swap && !undo)) thrM("Native compiler: Invalid header");
+    if (w>=0 && NN(w)->k==NK_SPEC) thrM("Native compiler: 𝕨 in headers isn't supported");
+    if (x<0) {
+      if (w>=0 || undo) thrM("Native compiler: Invalid header");
+      b->hk = HK_LABEL;
+    } else if (undo) {
+      if (w<0 && swap) thrM("Native compiler: Invalid header");
+      b->hk = w<0? HK_INVM : swap? HK_INVW : HK_INVX;
+    } else b->hk = w<0? HK_MON : HK_DY;
+    b->hty = ty;
+    BIND(ty==0? 0 : 3, t[k]);
+    if (ty!=0) BIND(4, t[k-1]);
+    if (ty==2) BIND(5, t[k+1]);
+    if (x>=0) BIND(1, x);
+    if (w>=0) BIND(2, w);
+  }
+  #undef BIND
+  NV_FREE(T);
+  b->hdrN = H->size/2;
+  b->hdr = nc_kids(c, H);
+}
+static NOINLINE i32 nc_block(NComp* c) { // parses a block, after its '{'
+  i32 s = NV_P(NTok, c->toks)[c->ti-1].s;
+  i32 id = NV_ADD(NBlock, c->blocks, ((NBlock){0}));
+  i32 pcb = c->cb;
+  c->cb = id;
+  TStack* bodies = nv_new(sizeof(NBody), 2);
   while (true) {
-    B ct;
-    if (i==tia) ct = m_c32(0);
-    else ct = GetU(tokens, i++);
-    // printf("next token: "); printI(ct); printf("\n");
-    
-    if (isC32(ct)) {
-      u32 ctc = o2cG(ct);
-      if (ctc=='\0' || ctc==close || ctc==',') {
-        if (IA(parts)>0) {
-          nc_add(&statements, nc_generate(parts));
-          parts = emptyHVec();
-        }
-        if (ctc==close) {
-          decG(parts);
-          break;
-        }
-        
-        if (ctc=='\0') thrM("Native compiler: Unclosed");
-        if (close==U')') thrM("Native compiler: Multiple statements in parens");
-      } else if (ctc=='(' || ctc==U'⟨') {
-        usz iM;
-        B res = nc_parseStatements(tokens, i, &iM, ctc=='('? ')' : U'⟩', objs, vars);
-        i = iM;
-        nc_add(&parts, res);
-      } else if (ctc==U'{' || ctc==U'}') {
-        thrM("Native compiler: Nested blocks aren't supported");
-      } else if (ctc==U'←' || ctc==U'↩') {
-        thrM("Native compiler: Invalid assignment");
-      } else if (ctc=='.') {
-        if (IA(parts)==0 || i==i0+1) thrM("Native compiler: Expected value before '.'");
-        
-        B ns = nc_pop(&parts);
-        if (nc_ty(ns) != 3) thrM("Native compiler: Expected subject before '.'");
-        
-        if (i==tia) thrM("Native compiler: Expression ended with '.'");
-        B name = GetU(tokens, i++);
-        if (!isArr(name) || RNK(name)!=1) thrM("Native compiler: Expected name to follow '.'");
-        
-        B bc = nc_emptyI32Vec();
-        nc_ijoin(&bc, IGetU(ns, 1));
-        decG(ns);
-        nc_iadd(&bc, FLDG);
-        nc_iadd(&bc, str2gid(IGetU(name,1)));
-        nc_add(&parts, m_hvec2(IGet(name,0), bc));
-      } else thrF("Native compiler: Unexpected character token \\u%xi / %i", ctc, ctc);
-    } else if (isArr(ct)) {
-      if (RNK(ct)==0) { // literal
-        B val = IGetU(ct, 0);
-        usz j = addObj(objs, inc(val));
-        i32 type = isFun(val)? 0 : isMd1(val)? 1 : isMd2(val)? 2 : 3;
-        nc_add(&parts, m_hvec2(m_f64(type), nc_ivec2(PUSH, j)));
-      } else { // name
-        u8 ty = nc_ty(ct);
-        u8 rty = ty;
-        assert(ty<=3);
-        if (i<tia) {
-          B ct2 = GetU(tokens, i);
-          if (isC32(ct2) && (o2cG(ct2)==U'←' || o2cG(ct2)==U'↩')) {
-            rty = o2cG(ct2)==U'←'? 4 : 5;
-            i++;
-          }
-        }
-        nc_add(&parts, m_hvec3(m_f64(rty), nc_ivec3(rty<=3? VARO : VARM, 0, nc_var(vars, IGetU(ct, 1))), m_f64(ty)));
+    NBody b = {.hk = HK_NONE};
+    nc_skipSeps(c);
+    if (nc_isHeader(c)) nc_header(c, &b);
+    TStack* st = nv_new(sizeof(i32), 8);
+    while (true) {
+      nc_skipSeps(c);
+      if (TK.k==';' || TK.k=='}') break;
+      i32 e = nc_expr(c);
+      if (e<0) nc_unexpected(c);
+      if (TK.k=='?') {
+        e = nc_node(c, NK_PRED, 3, e, 0, 0, 0, NN(e)->s, TK.e);
+        c->ti++;
+        b.pred = true;
+        NV_ADD(i32, st, e);
+        continue;
+      }
+      NV_ADD(i32, st, e);
+      if (TK.k!=',' && TK.k!=';' && TK.k!='}') nc_unexpected(c);
+    }
+    if (st->size==0) thrM("Native compiler: Empty block body");
+    b.stN = st->size;
+    b.st = nc_kids(c, st);
+    NV_ADD(NBody, bodies, b);
+    if (c->ti++, NV_P(NTok, c->toks)[c->ti-1].k=='}') break;
+  }
+  i32 e = NV_P(NTok, c->toks)[c->ti-1].e;
+  c->cb = pcb;
+
+  // block type, from the special names used and the headers
+  NBody* bs = NV_P(NBody, bodies);
+  i32 bn = bodies->size;
+  u8 uses = NV_P(NBlock, c->blocks)[id].uses;
+  u8 ty = uses&4? 2 : uses&2? 1 : 0;
+  bool args = uses&1, modLabel = false;
+  for (i32 i = 0; i < bn; i++) if (bs[i].hk!=HK_NONE) {
+    if (bs[i].hty > ty) ty = bs[i].hty;
+    if (bs[i].hk==HK_LABEL && bs[i].hty!=0) modLabel = true;
+    else args = true;
+  }
+  for (i32 i = 0; i < bn; i++) if (bs[i].hk!=HK_NONE && bs[i].hty!=ty) thrM("Native compiler: Header doesn't match the block type");
+  if (modLabel && args) thrM("Native compiler: Immediate modifier header in a block with arguments");
+  bool imm = !args;
+
+  // body lists
+  if (imm) {
+    if (ty==0 && bn>1) for (i32 i = 0; i < bn; i++) if (bs[i].hk!=HK_NONE) thrM("Native compiler: Header in an immediate block");
+    for (i32 i = 0; i < bn; i++) {
+      if (i!=bn-1 && !bs[i].pred && bs[i].hk==HK_NONE) thrM("Native compiler: Unreachable body");
+      bs[i].lists = 1;
+    }
+  } else {
+    i32 plain = 0; // header-less bodies without predicates; one is ambivalent, two are monadic and dyadic
+    bool cases = false; // header-less bodies with predicates, which are ambivalent
+    for (i32 i = 0; i < bn; i++) {
+      if (bs[i].hk!=HK_NONE) { if (plain) thrM("Native compiler: Header-less body before a body with a header"); }
+      else if (bs[i].pred) { if (plain) thrM("Native compiler: Unreachable body"); cases = true; }
+      else plain++;
+    }
+    if (plain>2) thrM("Native compiler: More than two header-less bodies");
+    if (plain==2 && cases) thrM("Native compiler: Predicates alongside monadic and dyadic header-less bodies aren't supported");
+    for (i32 i = 0; i < bn; i++) {
+      u8 hk = bs[i].hk;
+      bs[i].lists = hk==HK_NONE? (plain<2? 3 : i==bn-1? 2 : 1) : hk==HK_LABEL? 3 : hk==HK_MON? 1 : hk==HK_DY? 2 : hk==HK_INVM? 4 : hk==HK_INVX? 8 : 16;
+    }
+  }
+
+  i32 b0 = c->bodies->size;
+  for (i32 i = 0; i < bn; i++) NV_ADD(NBody, c->bodies, bs[i]);
+  NV_FREE(bodies);
+  NBlock* bl = NV_P(NBlock, c->blocks)+id;
+  bl->ty = ty;
+  bl->imm = imm;
+  bl->body = b0;
+  bl->bodyN = bn;
+  return nc_node(c, NK_BLOCK, ty!=0? ty : imm? 3 : 0, id, 0, 0, 0, s, e);
+}
+
+
+
+// emitter
+static NOINLINE void nc_emit(NComp* c, i32 n, i32 op, i32 argAm, i32 a0, i32 a1) { // emits op with argAm arguments, attributed to the source of node n
+  i32 w[3] = {op, a0, a1};
+  i32 s = NN(n)->s, e = NN(n)->e-1;
+  for (i32 i = 0; i <= argAm; i++) {
+    NV_ADD(i32, c->bc, w[i]);
+    NV_ADD(i32, c->bs, s);
+    NV_ADD(i32, c->be, e);
+  }
+}
+static NScope* nc_sc(NComp* c, i32 sc) { return NV_P(NScope, c->scopes)+sc; }
+static NOINLINE i32 nc_newScope(NComp* c, i32 parent, u8 sStart) {
+  i32 v = c->vars->size;
+  return NV_ADD(NScope, c->scopes, ((NScope){.parent = parent, .v0 = v, .vN = v, .sStart = sStart}));
+}
+static NOINLINE void nc_addVar(NComp* c, i32 sc, NVar v) {
+  assert(sc == c->scopes->size-1 && nc_sc(c,sc)->vN == c->vars->size);
+  NV_ADD(NVar, c->vars, v);
+  nc_sc(c,sc)->vN++;
+}
+static i32 nc_findLocal(NComp* c, i32 sc, i32 name) { // position of name in sc, or -1
+  NScope* s = nc_sc(c, sc);
+  NVar* v = NV_P(NVar, c->vars);
+  for (i32 i = s->v0; i < s->vN; i++) if (v[i].name==name) return i - s->v0;
+  return -1;
+}
+static NOINLINE void nc_find(NComp* c, i32 sc, i32 name, i32* depth, i32* pos) {
+  i32 d = 0;
+  while (sc>=0) {
+    i32 p = nc_findLocal(c, sc, name);
+    if (p>=0) { *depth = d; *pos = p; return; }
+    sc = nc_sc(c, sc)->parent;
+    d++;
+  }
+  thrF("Native compiler: Undefined identifier \"%R\"", IGetU(c->names, name));
+}
+
+static NOINLINE void nc_define(NComp* c, i32 sc, i32 n, bool exported) { // defines the names assigned by target n in scope sc
+  NNode t = *NN(n);
+  switch (t.k) {
+    default: thrM("Native compiler: Invalid assignment target");
+    case NK_LIT: case NK_NOTHING: break;
+    case NK_NAME: {
+      i32 p = nc_findLocal(c, sc, t.a);
+      if (p<0) { nc_addVar(c, sc, (NVar){.name = t.a, .exported = exported}); break; }
+      NVar* v = NV_P(NVar, c->vars) + nc_sc(c,sc)->v0 + p;
+      if (!v->loose) thrF("Native compiler: Redefinition of \"%R\"", IGetU(c->names, t.a));
+      v->exported|= exported;
+      break;
+    }
+    case NK_LIST: case NK_ARR:
+      for (i32 i = 0; i < t.b; i++) {
+        i32 e = nc_kid(c, t.a+i);
+        nc_define(c, sc, NN(e)->k==NK_SET? NN(e)->a : e, exported);
       }
-    } else thrF("Native compiler: Unexpected token %B", ct);
-  }
-  *i1 = i;
-  
-  // merge statements
-  SGetU(statements)
-  B final = nc_emptyI32Vec();
-  usz segAm = IA(statements);
-  for (usz i = 0; i < segAm; i++) {
-    B segment = GetU(statements, i);
-    if (i && close!=U'⟩') nc_iadd(&final, POPS);
-    nc_ijoin(&final, IGetU(segment, 1));
-  }
-  
-  u8 type0 = segAm==1? nc_ty(GetU(statements,0)) : 99;
-  decG(statements);
-  
-  u8 type;
-  if (close=='\0' || close=='}') {
-    nc_iadd(&final, RETN);
-    type = 0;
-  } else if (close==U'⟩') {
-    nc_iadd(&final, LSTO);
-    nc_iadd(&final, segAm);
-    type = 3;
-  } else if (close==')') {
-    type = type0;
-  } else thrM("bad closing");
-  return m_hvec2(m_f64(type), final);
-}
-
-NOINLINE usz nc_skipSeparators(B tokens, usz i) {
-  while (i < IA(tokens) && isC32(IGetU(tokens,i)) && o2cG(IGetU(tokens,i))==',') i++;
-  return i;
-}
-
-B nc_parseBlock(B tokens, usz i0, u32 end, bool isBlock, B* objs, u32* varCount) { // returns bytecode
-  usz i1;
-  #if FAST_NATIVE_COMP
-  H_b2i* vars0 = m_b2i(32);
-  #else
-  B vars0 = emptyHVec();
-  #endif
-  Vars vars = &vars0;
-  B toFree = emptyHVec();
-  if (isBlock) {
-    B t;
-    t=m_c32vec(U"𝕤", 1); nc_var(vars, t); nc_add(&toFree, t);
-    t=m_c32vec(U"𝕩", 1); nc_var(vars, t); nc_add(&toFree, t);
-    t=m_c32vec(U"𝕨", 1); nc_var(vars, t); nc_add(&toFree, t);
-  }
-  B r0 = nc_parseStatements(tokens, i0, &i1, end, objs, vars);
-  #if FAST_NATIVE_COMP
-  *varCount = vars0->pop;
-  free_b2i(vars0);
-  #else
-  *varCount = IA(vars0);
-  decG(vars0);
-  #endif
-  i1 = nc_skipSeparators(tokens, i1);
-  if (i1 != IA(tokens)) thrM("Native compiler: Code present after block end");
-  B r = TO_GET(r0, 1);
-  decG(toFree);
+      break;
+  }
+  if (exported) nc_sc(c,sc)->ns = true;
+}
+static NOINLINE void nc_defs(NComp* c, i32 sc, i32 n) { // defines everything that statement n defines
+  NNode t = *NN(n);
+  switch (t.k) {
+    default: break;
+    case NK_LIST: case NK_ARR: for (i32 i = 0; i < t.b; i++) nc_defs(c, sc, nc_kid(c, t.a+i)); break;
+    case NK_SET: if (t.x!=1) nc_define(c, sc, t.a, t.x==2); nc_defs(c, sc, t.b); break;
+    case NK_SETM: nc_defs(c, sc, t.b); if (t.c>=0) nc_defs(c, sc, t.c); break;
+    case NK_FIELD: case NK_PRED: nc_defs(c, sc, t.a); break;
+    case NK_CALL1: case NK_MD1: case NK_ATOP: nc_defs(c, sc, t.b); nc_defs(c, sc, t.a); break;
+    case NK_CALL2: case NK_MD2: case NK_FORK: nc_defs(c, sc, t.c); nc_defs(c, sc, t.b); nc_defs(c, sc, t.a); break;
+  }
+}
+static NOINLINE void nc_exports(NComp* c, i32 sc, i32 n) { // marks the names of an a⇐ declaration as exported
+  NNode t = *NN(n);
+  if (t.k==NK_NAME) {
+    i32 p = nc_findLocal(c, sc, t.a);
+    if (p<0) thrF("Native compiler: Exported name \"%R\" isn't defined in this block", IGetU(c->names, t.a));
+    NV_P(NVar, c->vars)[nc_sc(c,sc)->v0 + p].exported = true;
+    nc_sc(c,sc)->ns = true;
+  } else if (t.k==NK_LIST || t.k==NK_ARR) {
+    for (i32 i = 0; i < t.b; i++) {
+      i32 e = nc_kid(c, t.a+i);
+      if (NN(e)->k!=NK_NAME) thrM("Native compiler: Invalid export declaration");
+      nc_exports(c, sc, e);
+    }
+  } else thrM("Native compiler: Invalid export declaration");
+}
+
+static void nc_val(NComp* c, i32 sc, i32 n);
+static NOINLINE void nc_lhs(NComp* c, i32 sc, i32 n, u8 mode) { // pushes target n; mode: 0 for ← and ⇐, 1 for ↩, 2 for headers
+  NNode t = *NN(n);
+  switch (t.k) {
+    default: thrM("Native compiler: Invalid assignment target");
+    case NK_NAME: {
+      i32 d = 0, p;
+      if (mode==1) nc_find(c, sc, t.a, &d, &p);
+      else p = nc_findLocal(c, sc, t.a);
+      assert(p>=0);
+      nc_emit(c, n, VARM, 2, d, p);
+      break;
+    }
+    case NK_LIT:
+      if (mode!=2) thrM("Native compiler: Invalid assignment target");
+      nc_emit(c, n, PUSH, 1, t.a, 0);
+      nc_emit(c, n, VFYM, 0, 0, 0);
+      break;
+    case NK_LIST: case NK_ARR:
+      for (i32 i = 0; i < t.b; i++) {
+        i32 e = nc_kid(c, t.a+i);
+        NNode et = *NN(e);
+        if (et.k==NK_NOTHING) {
+          nc_emit(c, e, NOTM, 0, 0, 0);
+        } else if (et.k==NK_SET) { // alias
+          assert(et.x==2 && NN(et.b)->k==NK_NAME);
+          nc_lhs(c, sc, et.a, mode);
+          nc_emit(c, e, ALIM, 1, NN(et.b)->a, 0);
+        } else nc_lhs(c, sc, e, mode);
+      }
+      nc_emit(c, n, t.k==NK_LIST? LSTM : ARMM, 1, t.b, 0);
+      break;
+  }
+}
+static bool nc_maybeN(NComp* c, i32 n) { // whether n can evaluate to ·, i.e. it's 𝕨, or a call whose 𝕩 can be ·
+  NNode t = *NN(n);
+  if (t.k==NK_SPEC) return t.a==2;
+  if (t.k==NK_CALL1) return nc_maybeN(c, t.b);
+  if (t.k==NK_CALL2) return nc_maybeN(c, t.c);
+  return false;
+}
+static bool nc_nothingN(NComp* c, i32 n) { // whether n, pushed with nc_valN, can be ·; the C forms of calls and trains are used when not
+  return NN(n)->k==NK_NOTHING || nc_maybeN(c, n);
+}
+static void nc_valO(NComp* c, i32 sc, i32 n);
+static NOINLINE void nc_valN(NComp* c, i32 sc, i32 n) { // pushes n where · is allowed, i.e. 𝕨 of a call or the left tine of a train
+  if (NN(n)->k==NK_NOTHING) nc_emit(c, n, NOTM, 0, 0, 0);
+  else nc_valO(c, sc, n);
+}
+static NOINLINE void nc_val(NComp* c, i32 sc, i32 n) { // pushes the value of n, erroring if it's ·
+  nc_valO(c, sc, n);
+  if (nc_maybeN(c, n)) nc_emit(c, n, CHKV, 0, 0, 0);
+}
+static NOINLINE void nc_valO(NComp* c, i32 sc, i32 n) { // pushes n without checking for ·, for places that either allow it or pass it on
+  NNode t = *NN(n);
+  switch (t.k) { default: UD;
+    case NK_LIT: nc_emit(c, n, PUSH, 1, t.a, 0); break;
+    case NK_NAME: {
+      i32 d, p;
+      nc_find(c, sc, t.a, &d, &p);
+      nc_emit(c, n, VARO, 2, d, p);
+      break;
+    }
+    case NK_SPEC: {
+      NScope* s = nc_sc(c, sc);
+      assert(t.a >= s->sStart);
+      nc_emit(c, n, VARO, 2, 0, t.a - s->sStart);
+      break;
+    }
+    case NK_NOTHING: thrM("Native compiler: Unexpected ·");
+    case NK_EXPORT: thrM("Native compiler: Export declaration used as a value");
+    case NK_PRED: thrM("Native compiler: Predicate used as a value");
+    case NK_BLOCK:
+      NV_P(NBlock, c->blocks)[t.a].parent = sc;
+      NV_ADD(i32, c->queue, t.a);
+      nc_emit(c, n, DFND, 1, t.a, 0);
+      break;
+    case NK_LIST: case NK_ARR:
+      for (i32 i = 0; i < t.b; i++) nc_val(c, sc, nc_kid(c, t.a+i));
+      nc_emit(c, n, t.k==NK_LIST? LSTO : ARMO, 1, t.b, 0);
+      break;
+    case NK_FIELD: nc_val(c, sc, t.a); nc_emit(c, n, FLDO, 1, t.b, 0); break;
+    case NK_CALL1: nc_valO(c, sc, t.b); nc_val(c, sc, t.a); nc_emit(c, t.a, nc_maybeN(c, t.b)? FN1O : FN1C, 0, 0, 0); break; // a · 𝕩 makes the result ·
+    case NK_CALL2: nc_valO(c, sc, t.c); nc_val(c, sc, t.b); nc_valN(c, sc, t.a); nc_emit(c, t.b, nc_maybeN(c, t.c) || nc_nothingN(c, t.a)? FN2O : FN2C, 0, 0, 0); break;
+    case NK_MD1:   nc_val(c, sc, t.b); nc_val(c, sc, t.a); nc_emit(c, t.b, MD1C, 0, 0, 0); break;
+    case NK_MD2:   nc_val(c, sc, t.c); nc_val(c, sc, t.b); nc_val(c, sc, t.a); nc_emit(c, t.b, MD2C, 0, 0, 0); break;
+    case NK_ATOP:  nc_val(c, sc, t.b); nc_val(c, sc, t.a); nc_emit(c, n, TR2D, 0, 0, 0); break;
+    case NK_FORK:  nc_val(c, sc, t.c); nc_val(c, sc, t.b); nc_valN(c, sc, t.a); nc_emit(c, n, nc_nothingN(c, t.a)? TR3O : TR3D, 0, 0, 0); break;
+    case NK_SET:
+      nc_val(c, sc, t.b);
+      nc_lhs(c, sc, t.a, t.x==1);
+      nc_emit(c, n, t.x==1? SETU : SETN, 0, 0, 0);
+      break;
+    case NK_SETM:
+      if (t.c>=0) nc_val(c, sc, t.c);
+      nc_val(c, sc, t.b);
+      nc_lhs(c, sc, t.a, 1);
+      nc_emit(c, t.b, t.c>=0? SETM : SETC, 0, 0, 0);
+      break;
+  }
+}
+
+static NOINLINE void nc_body(NComp* c, NBody* bp, i32 parent, u8 ty, bool imm, bool top) { // emits a body, defining its variables in a new scope
+  NBody b = *bp;
+  i32 sc;
+  if (top) {
+    sc = c->scopes->size-1; // already made with any REPL variables
+  } else {
+    u8 sStart = imm? 3 : 0;
+    u8 sEnd = ty==0? 3 : ty==1? 5 : 6;
+    sc = nc_newScope(c, parent, sStart);
+    for (u8 i = sStart; i < sEnd; i++) nc_addVar(c, sc, (NVar){.name = -1});
+  }
+  i32* st = NV_P(i32, c->kids) + b.st;
+  for (i32 i = 0; i < b.hdrN; i++) nc_define(c, sc, nc_kid(c, b.hdr+i*2+1), false);
+  for (i32 i = 0; i < b.stN; i++) nc_defs(c, sc, st[i]);
+  for (i32 i = 0; i < b.stN; i++) if (NN(st[i])->k==NK_EXPORT) nc_exports(c, sc, NN(st[i])->a);
+  bool ns = nc_sc(c, sc)->ns;
+  if (ns && !(top || (imm && ty==0))) thrM("Native compiler: Exports are only supported in immediate blocks");
+
+  bp->idx = NV_ADD(NOutBody, c->out, ((NOutBody){.start = c->bc->size, .scope = sc}));
+  for (i32 i = 0; i < b.hdrN; i++) {
+    i32 sp = nc_kid(c, b.hdr+i*2);
+    i32 pat = nc_kid(c, b.hdr+i*2+1);
+    nc_emit(c, pat, VARO, 2, 0, sp - nc_sc(c,sc)->sStart);
+    nc_lhs(c, sc, pat, 2);
+    nc_emit(c, pat, SETH, 0, 0, 0);
+  }
+  bool hasVal = false;
+  i32 last = -1;
+  i32 fin = b.stN-1; // the statement giving the result
+  while (fin>0 && NN(st[fin])->k==NK_EXPORT) fin--;
+  for (i32 i = 0; i < b.stN; i++) {
+    i32 s = NV_P(i32, c->kids)[b.st+i];
+    NNode t = *NN(s);
+    if (t.k==NK_EXPORT) continue;
+    if (hasVal) nc_emit(c, last, POPS, 0, 0, 0);
+    if (t.k==NK_PRED) {
+      nc_val(c, sc, t.a);
+      nc_emit(c, s, PRED, 0, 0, 0);
+      hasVal = false;
+    } else {
+      if (i==fin || ns) nc_val(c, sc, s);
+      else nc_valO(c, sc, s); // popped, so it may be ·
+      hasVal = true;
+    }
+    last = s;
+  }
+  if (ns) {
+    nc_emit(c, last>=0? last : st[b.stN-1], RETD, 0, 0, 0);
+  } else {
+    if (!hasVal) thrM("Native compiler: Block body must end with an expression");
+    nc_emit(c, last, RETN, 0, 0, 0);
+  }
+}
+
+static NOINLINE B nc_ivec(NComp* c, TStack* v, i32 off, usz n) {
+  i32* rp; B r = m_i32arrv(&rp, n);
+  if (n) memcpy(rp, NV_P(i32,v)+off, n*sizeof(i32));
   return r;
 }
+static NOINLINE B nc_bodyObj(NComp* c, NBlock bl) {
+  NBody* bs = NV_P(NBody, c->bodies) + bl.body;
+  if (bl.bodyN==1 && (bl.imm || (bs[0].hk==HK_NONE && bs[0].lists==3))) return m_f64(bs[0].idx);
+  i32 n = bl.imm? 1 : 0;
+  for (i32 l = 0; l < 5; l++) for (i32 i = 0; i < bl.bodyN; i++) if (bs[i].lists & (1<<l)) n = l+1;
+  M_HARR(r, n)
+  for (i32 l = 0; l < n; l++) {
+    usz am = 0;
+    for (i32 i = 0; i < bl.bodyN; i++) am+= (bs[i].lists>>l) & 1;
+    i32* rp; B li = m_i32arrv(&rp, am);
+    for (i32 i = 0; i < bl.bodyN; i++) if (bs[i].lists & (1<<l)) *rp++ = bs[i].idx;
+    HARR_ADD(r, l, li);
+  }
+  return HARR_FV(r);
+}
 
 B nativeComp_c2(B t, B w, B x) {
   SGetU(w)
-  B prims = GetU(w,0);
-  B sysvs = GetU(w,1);
-  bool fnBlock = false;
-  
+  usz wia = IA(w);
+  NComp cs = {
+    .toks = nv_new(sizeof(NTok), 64), .nodes = nv_new(sizeof(NNode), 64), .kids = nv_new(sizeof(i32), 64),
+    .bodies = nv_new(sizeof(NBody), 8), .blocks = nv_new(sizeof(NBlock), 8), .scopes = nv_new(sizeof(NScope), 8),
+    .vars = nv_new(sizeof(NVar), 16), .queue = nv_new(sizeof(i32), 8), .out = nv_new(sizeof(NOutBody), 8),
+    .bc = nv_new(sizeof(i32), 64), .bs = nv_new(sizeof(i32), 64), .be = nv_new(sizeof(i32), 64),
+    .objs = emptyHVec(), .names = emptyHVec(), .nameMap = m_b2i(16),
+    .prims = GetU(w,0), .sys = GetU(w,1),
+  };
+  NComp* c = &cs;
+  for (usz i = 0; i < 64; i++) c->primObj[i] = -1;
+
   // tokenize
   usz xia = IA(x);
-  u32* xBuf; B xBufO = m_c32arrv(&xBuf, xia+1);
+  u32* xBuf; B xBufO = m_c32arrv(&xBuf, xia+2);
   SGetU(x)
   for (usz i = 0; i < xia; i++) xBuf[i] = o2c(GetU(x, i));
-  xBuf[xia] = 0;
-  B tokens = nc_tokenize(prims, sysvs, xBuf, xia, &fnBlock);
-  decG(xBufO);
-  
+  xBuf[xia] = xBuf[xia+1] = 0;
+  c->src = xBuf;
+  nc_tokenize(c, xia);
+
   // parse
-  B objs = emptyHVec();
-  i32* bc0;
-  B bytecode = m_i32arrv(&bc0, fnBlock? 3 : 0);
-  usz i0 = nc_skipSeparators(tokens, 0);
-  bool anyBlock = i0<IA(tokens) && isC32(IGetU(tokens,i0)) && o2cG(IGetU(tokens,i0))=='{';
-  if (anyBlock) i0++;
-  if (fnBlock) {
-    bc0[0] = DFND;
-    bc0[1] = 1;
-    bc0[2] = RETN;
-  }
-  u32 varCount;
-  if (fnBlock && !anyBlock) thrM("Native compiler: 𝕨/𝕩 outside block");
-  B bc1 = nc_parseBlock(tokens, i0, anyBlock? '}' : '\0', fnBlock, &objs, &varCount);
-  nc_ijoin(&bytecode, bc1);
-  decG(bc1);
-  decG(tokens);
-  
-  // build result
-  B res;
-  if (fnBlock) {
-    res = m_hvec4(
-      bytecode,
-      objs,
-      m_hvec2(nc_ivec3(0, 1, 0), nc_ivec3(0, 0, 1)),
-      m_hvec2(nc_ivec2(0, 0), nc_ivec2(3, varCount))
-    );
-  } else {
-    res = m_hvec4(
-      bytecode,
-      objs,
-      m_hvec1(nc_ivec3(0, 1, 0)),
-      m_hvec1(nc_ivec2(0, varCount))
-    );
-  }
-  
+  NV_ADD(NBlock, c->blocks, ((NBlock){.imm = true, .bodyN = 1}));
+  TStack* st = nv_new(sizeof(i32), 8);
+  while (true) {
+    nc_skipSeps(c);
+    if (TK.k==NT_END) break;
+    i32 e = nc_expr(c);
+    if (e<0 || (TK.k!=',' && TK.k!=NT_END)) nc_unexpected(c);
+    NV_ADD(i32, st, e);
+  }
+  if (st->size==0) thrM("Native compiler: Empty program");
+  if (NV_P(NBlock, c->blocks)[0].uses) thrM("Native compiler: Special name outside of a block");
+  NBody prog = {.lists = 1, .stN = st->size};
+  prog.st = nc_kids(c, st);
+  NV_P(NBlock, c->blocks)[0].body = NV_ADD(NBody, c->bodies, prog);
+
+  // scopes of REPL variables: depth -1 is redefinable, 0 is the program's own scope, and higher ones are its parents
+  i32 parent = -1;
+  if (wia==4) {
+    B vName = GetU(w,2); SGetU(vName)
+    B vDepth = GetU(w,3); SGetU(vDepth)
+    usz vn = IA(vName);
+    i32 maxDepth = 0;
+    for (usz i = 0; i < vn; i++) { i32 d = o2iG(GetU(vDepth,i)); if (d>maxDepth) maxDepth = d; }
+    for (i32 d = maxDepth; d >= 0; d--) {
+      parent = nc_newScope(c, parent, 0);
+      for (usz i = 0; i < vn; i++) {
+        i32 vd = o2iG(GetU(vDepth,i));
+        if (vd>0? vd!=d : d!=0) continue;
+        nc_addVar(c, parent, (NVar){.name = nc_nameId(c, inc(GetU(vName,i))), .loose = vd<0});
+      }
+    }
+  } else parent = nc_newScope(c, -1, 0);
+
+  // emit
+  nc_body(c, NV_P(NBody, c->bodies) + NV_P(NBlock, c->blocks)[0].body, -1, 0, true, true);
+  for (usz qi = 0; qi < c->queue->size; qi++) {
+    NBlock bl = NV_P(NBlock, c->blocks)[NV_P(i32, c->queue)[qi]];
+    for (i32 i = 0; i < bl.bodyN; i++) nc_body(c, NV_P(NBody, c->bodies)+bl.body+i, bl.parent, bl.ty, bl.imm, false);
+  }
+
+  // result
+  usz bcn = c->bc->size;
+  B bytecode = nc_ivec(c, c->bc, 0, bcn);
+  B inds = m_hvec2(nc_ivec(c, c->bs, 0, bcn), nc_ivec(c, c->be, 0, bcn));
+
+  usz bln = c->blocks->size;
+  M_HARR(blocks, bln)
+  for (usz i = 0; i < bln; i++) {
+    NBlock bl = NV_P(NBlock, c->blocks)[i];
+    HARR_ADD(blocks, i, m_hvec3(m_f64(bl.ty), m_f64(bl.imm), nc_bodyObj(c, bl)));
+  }
+
+  usz bon = c->out->size;
+  M_HARR(bodies, bon)
+  for (usz i = 0; i < bon; i++) {
+    NOutBody o = NV_P(NOutBody, c->out)[i];
+    NScope s = *nc_sc(c, o.scope);
+    NVar* v = NV_P(NVar, c->vars);
+    i32 v0 = s.v0;
+    while (v0 < s.vN && v[v0].name<0) v0++; // specials aren't listed
+    i32* ip; B ids = m_i32arrv(&ip, s.vN-v0);
+    i32* ep; B exp = m_i32arrv(&ep, s.vN-v0);
+    for (i32 j = v0; j < s.vN; j++) { ip[j-v0] = v[j].name; ep[j-v0] = v[j].exported; }
+    HARR_ADD(bodies, i, m_hvec4(m_f64(o.start), m_f64(s.vN-s.v0), ids, exp));
+  }
+
+  B tokenInfo = m_hvec3(emptyHVec(), emptyHVec(), m_hvec1(c->names));
+  B r = m_caB(6, (B[]){bytecode, c->objs, HARR_FV(blocks), HARR_FV(bodies), inds, tokenInfo});
+
+  TStack* all[] = {c->toks, c->nodes, c->kids, c->bodies, c->blocks, c->scopes, c->vars, c->queue, c->out, c->bc, c->bs, c->be};
+  for (usz i = 0; i < sizeof(all)/sizeof(all[0]); i++) NV_FREE(all[i]);
+  free_b2i(c->nameMap);
+  decG(xBufO);
   decG(w); decG(x);
-  return res;
+  return r;
 }
 
 void nativeCompiler_init() {
   native_comp = m_nfn(registerNFn(m_c8vec_0("(native compiler)"), c1_bad, nativeComp_c2), bi_N);
   gc_add(native_comp);
-}
\ No newline at end of file
+}
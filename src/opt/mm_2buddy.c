@@ -63,3 +63,9 @@ void mm_dumpHeap(FILE* f) {
 u64 mm_heapUsed() {
   return b1_heapUsed() + b3_heapUsed();
 }
+#if MULTI_INSTANCE
+void mm_freeArenas() {
+  b1_freeArenas();
+  b3_freeArenas();
+}
+#endif
@@ -43,6 +43,9 @@ static u64 mm_size(Value* x) {
 }
 void mm_forHeap(V2v f);
 void mm_dumpHeap(FILE* f);
+#if MULTI_INSTANCE
+  void mm_freeArenas(void);
+#endif
 
 #undef BN
 #undef BSZ
@@ -51,6 +51,9 @@ static u64 mm_sizeUsable(Value* x) {
 #endif
 void mm_forHeap(V2v f);
 void mm_dumpHeap(FILE* f);
+#if MULTI_INSTANCE
+  void mm_freeArenas(void);
+#endif
 
 #undef LOG2
 #undef BN
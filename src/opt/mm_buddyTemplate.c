@@ -192,6 +192,46 @@ NOINLINE u64 BN(heapUsed)() {
   return r;
 }
 
+#if HEAP_IMAGE
+u64 BN(imageArenas)(HeapArena* r) { // returns the number of arenas; if r!=NULL, also writes them there
+  if (r) for (u64 i = 0; i < alSize; i++) {
+    AllocInfo ci = al[i];
+    #if ALLOC_MODE==0
+      r[i] = (HeapArena){.p = ci.p, .sz = ci.sz, .mapP = (u8*)ci.p - ALLOC_PADDING, .mapSz = prepAllocSize(ci.sz)};
+    #else
+      r[i] = (HeapArena){.p = ci.p, .sz = ci.sz, .mapP = ci.p, .mapSz = ci.sz};
+    #endif
+  }
+  return alSize;
+}
+void BN(imageRestore)(HeapArena* a, u64 n) { // the arena list itself isn't in the image, so rebuild it
+  alSize = alCap = n;
+  al = malloc(sizeof(AllocInfo)*(n? n : 1));
+  for (u64 i = 0; i < n; i++) al[i] = (AllocInfo){.p = a[i].p, .sz = a[i].sz};
+}
+#endif
+
+#if MULTI_INSTANCE
+void BN(freeArenas)() { // release the whole heap; for discarding an interpreter instance
+  for (u64 i = 0; i < alSize; i++) {
+    u8* p = (u8*)al[i].p;
+    u64 sz = al[i].sz;
+    #if ALLOC_MODE==0
+      p-= ALLOC_PADDING;
+      sz = prepAllocSize(sz);
+    #endif
+    #if NO_MMAP
+      free(p);
+    #else
+      munmap(p, sz);
+    #endif
+  }
+  free(al);
+  al = NULL;
+  alSize = alCap = 0;
+}
+#endif
+
 void writeNum(FILE* f, u64 v, i32 len);
 void BN(dumpHeap)(FILE* f) {
   for (u64 i = 0; i < alSize; i++) {
@@ -36,6 +36,9 @@ static   void* BN(allocL)(i64 bucket, u8 type) {
   x->refc = 1;
   x->type = type;
   x->mmInfo = bucket;
+  #if ALLOC_SITES
+    ALLOC_SITE(x);
+  #endif
   #if OBJ_COUNTER
     x->uid = currObjCounter++;
     #ifdef OBJ_TRACK
@@ -14,6 +14,9 @@ static void* mm_alloc(u64 sz, u8 type) {
   x->flags = x->extra = x->mmInfo = x->type = 0;
   x->refc = 1;
   x->type = type;
+  #if ALLOC_SITES
+    ALLOC_SITE(x);
+  #endif
   return x;
 }
 
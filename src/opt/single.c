@@ -8,6 +8,7 @@
 #include "../core/tyarr.c"
 #include "../core/harr.c"
 #include "../core/fillarr.c"
+#include "../core/strlist.c"
 #include "../core/stuff.c"
 #include "../core/derv.c"
 #include "../core/mm.c"
@@ -18,6 +19,7 @@
 #include "../utils/mut.c"
 #include "../utils/each.c"
 #include "../utils/bits.c"
+#include "../utils/perf.c"
 #include "../utils/ryu.c"
 #include "../builtins/fns.c"
 #include "../builtins/sfns.c"
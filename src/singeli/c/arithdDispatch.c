@@ -67,8 +67,8 @@ NOINLINE B dyArith_AA(DyTableAA* table, B w, B x) {
       fn++;
       goto newFn;
     }
-    case u_call_rbyte: {
-      fn->uFn(m_tyarrlc(&r, fn->width, x, fn->type), tyany_ptr(w), tyany_ptr(x), ia);
+    case u_call_rbyte: { // unchecked, so can write over an unshared argument
+      fn->uFn(m_tyarrlbcR(&r, fn->width+3, x, w, fn->type), tyany_ptr(w), tyany_ptr(x), ia);
       goto decG_ret;
     }
     case e_call_rbyte: {
@@ -77,14 +77,15 @@ NOINLINE B dyArith_AA(DyTableAA* table, B w, B x) {
       goto decG_ret;
     }
     case u_call_bit: {
-      u64* rp; r = m_bitarrc(&rp, x);
+      u64* rp = m_tyarrlbcR(&r, 0, x, w, t_bitarr);
       fn->uFn(rp, tyany_ptr(w), tyany_ptr(x), ia);
       goto decG_ret;
     }
     
     case u_call_wxf64sq: {
-      f64* rp; r = m_f64arrc(&rp, x);
-      fn->uFn(rp, tyany_ptr(w = toF64Any(w)), tyany_ptr(x = toF64Any(x)), ia);
+      w = toF64Any(w); x = toF64Any(x);
+      f64* rp = m_tyarrlbcR(&r, 6, x, w, t_f64arr);
+      fn->uFn(rp, tyany_ptr(w), tyany_ptr(x), ia);
       r = num_squeeze(r);
       goto decG_ret;
     }
@@ -227,7 +228,7 @@ NOINLINE B dyArith_SA(DyTableSA* table, B w, B x) {
   iwiden_c16: if (q_i32(w)) { wa=(u32)o2iG(w); type=t_c32arr; goto cpy_c32; }
   goto rec;
   
-  // TODO reuse the copied array for the result; maybe even alternate copy & operation to stay in cache
+  // TODO reuse the copied integer array for the result (needs the checked functions to not restart from the argument); maybe even alternate copy & operation to stay in cache
   cpy_c16: x = taga(cpyC16Arr(x)); width=1; e=&table->ents[el_c16]; goto f1;
   cpy_c32: x = taga(cpyC32Arr(x)); width=2; e=&table->ents[el_c32]; goto f1;
   
@@ -237,7 +238,8 @@ NOINLINE B dyArith_SA(DyTableSA* table, B w, B x) {
   
   ChkFnSA fn; B r;
   f1: fn = e->f1;
-  u64 got = fn(m_tyarrlc(&r, width, x, type), wa, tyany_ptr(x), ia);
+  // f64 results are never overflow-checked, so those can write over an unshared argument, including one copied above
+  u64 got = fn(type==t_f64arr? m_tyarrlbcR(&r, 6, x, x, t_f64arr) : m_tyarrlc(&r, width, x, type), wa, tyany_ptr(x), ia);
   if (got==ia) goto decG_ret;
   decG(r);
   
@@ -21,12 +21,12 @@
   BITSEL_DEF(u16)
   BITSEL_DEF(u32)
   BITSEL_DEF(u64)
-  INIT_GLOBAL BitSelFn bitselFnsRaw[] = {bitsel_u8, bitsel_u16, bitsel_u32, bitsel_u64};
+  static BitSelFn bitselFnsRaw[] = {bitsel_u8, bitsel_u16, bitsel_u32, bitsel_u64};
   INIT_GLOBAL BitSelFn* bitselFns = bitselFnsRaw;
 #endif
 
-#if defined(__BMI2__) && !SLOW_PDEP
-  #define FAST_PDEP 1
+#include "../utils/cpu.h"
+#if CPU_DETECT
   #include <immintrin.h>
 #endif
 
@@ -129,45 +129,58 @@ FORCE_INLINE void ab_add(ABState* state, u64 val, ux count) { // assumes bits pa
 
 
 
+#if CPU_DETECT
+static TARGET_BMI2 void bitnarrow_pext(ABState* ab, ux rcsz, void* xp, ux xcsz, ux cam) { // bitnarrow for xcsz∊8‿16
+  assert(xcsz==8 || xcsz==16);
+  bool c8 = xcsz==8;
+  u64 tmsk = (1ull<<rcsz)-1;
+  u64 msk0 = tmsk * (c8? 0x0101010101010101 : 0x0001000100010001);
+  ux am = c8? cam/8 : cam/4;
+  u32 count = POPC(msk0);
+  for (ux i=0; i<am; i++) { ab_add(ab, _pext_u64(*(u64*)xp, msk0), count); xp = 1+(u64*)xp; }
+  u32 tb = c8? cam&7 : (cam&3)<<1;
+  if (tb) {
+    u64 msk1 = msk0 & ((1ull<<tb*8)-1);
+    ab_add(ab, _pext_u64(*(u64*)xp, msk1), POPC(msk1));
+  }
+}
+static TARGET_BMI2 void bitwiden_pdep(u64* rp64, ux rcsz, void* xp, ux xcsz, ux cam) { // bitwiden for rcsz∊8‿16
+  assert(rcsz==8 || rcsz==16);
+  bool c8 = rcsz==8;
+  u64 tmsk = (1ull<<xcsz)-1;
+  u64 msk0 = tmsk * (c8? 0x0101010101010101 : 0x0001000100010001);
+  ux am = c8? cam/8 : cam/4;
+  u32 count = POPC(msk0);
+  for (ux i=0; i<am; i++) { *rp64 = _pdep_u64(rbuu58(xp, i*count), msk0); rp64++; }
+  u32 tb = c8? cam&7 : (cam&3)<<1;
+  if (tb) {
+    u64 msk1 = msk0 & ((1ull<<tb*8)-1);
+    *rp64 = _pdep_u64(rbuu64(xp, am*count), msk1);
+  }
+}
+#endif
+
 NOINLINE void bitnarrow(void* rp, ux rcsz, void* xp, ux xcsz, ux cam) { // for now assumes the bits to be dropped are zero, xcsz is a multiple of 8, and that there's at most 63 padding bits
   assert((xcsz&7) == 0 && rcsz<xcsz && rcsz!=0);
   // FILL_TO(rp, el_bit, 0, m_f64(1), PIA(r));
   ABState ab = ab_new(rp);
   if (xcsz<=64 && (xcsz&(xcsz-1)) == 0) {
-    #if FAST_PDEP
-      if (xcsz<32) {
-        assert(xcsz==8 || xcsz==16);
-        bool c8 = xcsz==8;
-        u64 tmsk = (1ull<<rcsz)-1;
-        u64 msk0 = tmsk * (c8? 0x0101010101010101 : 0x0001000100010001);
-        ux am = c8? cam/8 : cam/4;
-        u32 count = POPC(msk0);
-        // printf("narrow base %04lx %016lx count=%d am=%zu\n", tmsk, msk0, count, am);
-        for (ux i=0; i<am; i++) { ab_add(&ab, _pext_u64(*(u64*)xp, msk0), count); xp = 1+(u64*)xp; }
-        u32 tb = c8? cam&7 : (cam&3)<<1;
-        if (tb) {
-          u64 msk1 = msk0 & ((1ull<<tb*8)-1);
-          // printf("narrow tail %4d %016lx count=%d\n", tb, msk1, POPC(msk1));
-          ab_add(&ab, _pext_u64(*(u64*)xp, msk1), POPC(msk1));
-        }
-      }
-      else if (xcsz==32) for (ux i=0; i<cam; i++) ab_add(&ab, ((u32*)xp)[i], rcsz);
-      else               for (ux i=0; i<cam; i++) ab_add(&ab, ((u64*)xp)[i], rcsz);
-    #else
-      switch(xcsz) { default: UD;
-        case 8:
-          #if SINGELI_NEON
-            if (xcsz==8 && rcsz!=1) {
-              si_bitnarrow_8_n(xp, rp, rcsz, cam);
-              return;
-            }
-          #endif
-        /* 8 */  for (ux i=0; i<cam; i++) ab_add(&ab, ((u8* )xp)[i], rcsz); break; // all assume zero padding
-        case 16: for (ux i=0; i<cam; i++) ab_add(&ab, ((u16*)xp)[i], rcsz); break;
-        case 32: for (ux i=0; i<cam; i++) ab_add(&ab, ((u32*)xp)[i], rcsz); break;
-        case 64: for (ux i=0; i<cam; i++) ab_add(&ab, ((u64*)xp)[i], rcsz); break;
-      }
+    #if CPU_DETECT
+      if (HAS_FAST_PDEP && xcsz<32) { bitnarrow_pext(&ab, rcsz, xp, xcsz, cam); ab_done(ab); return; }
     #endif
+    switch(xcsz) { default: UD;
+      case 8:
+        #if SINGELI_NEON
+          if (xcsz==8 && rcsz!=1) {
+            si_bitnarrow_8_n(xp, rp, rcsz, cam);
+            return;
+          }
+        #endif
+      /* 8 */  for (ux i=0; i<cam; i++) ab_add(&ab, ((u8* )xp)[i], rcsz); break; // all assume zero padding
+      case 16: for (ux i=0; i<cam; i++) ab_add(&ab, ((u16*)xp)[i], rcsz); break;
+      case 32: for (ux i=0; i<cam; i++) ab_add(&ab, ((u32*)xp)[i], rcsz); break;
+      case 64: for (ux i=0; i<cam; i++) ab_add(&ab, ((u64*)xp)[i], rcsz); break;
+    }
   } else {
     assert(xcsz-rcsz<64);
     ux rfu64 = rcsz>>6; // full u64 count per cell in x
@@ -213,32 +226,15 @@ NOINLINE void bitwiden(void* rp, ux rcsz, void* xp, ux xcsz, ux cam) { // for no
       }
     #endif
     u64 tmsk = (1ull<<xcsz)-1;
-    #if FAST_PDEP
-      if (rcsz<32) {
-        assert(rcsz==8 || rcsz==16);
-        bool c8 = rcsz==8;
-        u64 msk0 = tmsk * (c8? 0x0101010101010101 : 0x0001000100010001);
-        ux am = c8? cam/8 : cam/4;
-        u32 count = POPC(msk0);
-        // printf("widen base %04lx %016lx count=%d am=%zu\n", tmsk, msk0, count, am);
-        for (ux i=0; i<am; i++) { *rp64 = _pdep_u64(rbuu58(xp, i*count), msk0); rp64++; }
-        u32 tb = c8? cam&7 : (cam&3)<<1;
-        if (tb) {
-          u64 msk1 = msk0 & ((1ull<<tb*8)-1);
-          // printf("widen tail %4d %016lx count=%d\n", tb, msk1, POPC(msk1));
-          *rp64 = _pdep_u64(rbuu64(xp, am*count), msk1);
-        }
-      }
-      else if (rcsz==32) for (ux i=0; i<cam; i++) ((u32*)rp)[i] = rbuu58(xp, i*xcsz)&tmsk;
-      else               for (ux i=0; i<cam; i++) ((u64*)rp)[i] = rbuu64(xp, i*xcsz)&tmsk;
-    #else
-      switch(rcsz) { default: UD;
-        case  8: for (ux i=0; i<cam; i++) ((u8* )rp)[i] = rbuu58(xp, i*xcsz)&tmsk; break;
-        case 16: for (ux i=0; i<cam; i++) ((u16*)rp)[i] = rbuu58(xp, i*xcsz)&tmsk; break;
-        case 32: for (ux i=0; i<cam; i++) ((u32*)rp)[i] = rbuu58(xp, i*xcsz)&tmsk; break;
-        case 64: for (ux i=0; i<cam; i++) ((u64*)rp)[i] = rbuu64(xp, i*xcsz)&tmsk; break;
-      }
+    #if CPU_DETECT
+      if (HAS_FAST_PDEP && rcsz<32) { bitwiden_pdep(rp64, rcsz, xp, xcsz, cam); return; }
     #endif
+    switch(rcsz) { default: UD;
+      case  8: for (ux i=0; i<cam; i++) ((u8* )rp)[i] = rbuu58(xp, i*xcsz)&tmsk; break;
+      case 16: for (ux i=0; i<cam; i++) ((u16*)rp)[i] = rbuu58(xp, i*xcsz)&tmsk; break;
+      case 32: for (ux i=0; i<cam; i++) ((u32*)rp)[i] = rbuu58(xp, i*xcsz)&tmsk; break;
+      case 64: for (ux i=0; i<cam; i++) ((u64*)rp)[i] = rbuu64(xp, i*xcsz)&tmsk; break;
+    }
   } else {
     assert((rcsz&63) == 0 && rcsz-xcsz < 64 && (xcsz&63) != 0);
     ux pfu64 = xcsz>>6; // previous full u64 count in cell
@@ -0,0 +1,23 @@
+#include "../core.h"
+#include "cpu.h"
+
+#if CPU_DETECT
+INIT_GLOBAL bool cpu_bmi2;
+INIT_GLOBAL bool cpu_fastPdep;
+
+void cpu_init(void) {
+  __builtin_cpu_init(); // runs cpuid
+  cpu_bmi2 = __builtin_cpu_supports("bmi2");
+  cpu_fastPdep = cpu_bmi2 && !__builtin_cpu_is("znver1") && !__builtin_cpu_is("znver2");
+}
+
+STATIC_GLOBAL char cpu_featureBuf[64];
+char* cpu_features(void) {
+  char* buf = cpu_featureBuf;
+  snprintf(buf, 64, "x86-64%s%s", cpu_bmi2? " bmi2" : "", cpu_bmi2 && !cpu_fastPdep? " slow-pdep" : "");
+  return buf;
+}
+#else
+void cpu_init(void) { }
+char* cpu_features(void) { return "none detected"; }
+#endif
@@ -0,0 +1,30 @@
+#pragma once
+
+// Instruction set extensions of the CPU we're running on, detected with cpuid by cpu_init
+// For code paths that use an extension the build doesn't assume (e.g. a non-native x86-64 build on an AVX2+BMI2 machine): compile the fast version with TARGET_* and pick it with HAS_* at runtime
+// HAS_* is a compile-time 1 when the build already assumes the extension, so such checks cost nothing in native builds
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  extern INIT_GLOBAL bool cpu_bmi2;      // BMI2 (pdep, pext, bzhi, shlx…)
+  extern INIT_GLOBAL bool cpu_fastPdep;  // BMI2 with pdep/pext not microcoded (i.e. not AMD before Zen 3)
+  #define CPU_DETECT 1
+  #define TARGET_BMI2 __attribute__((target("bmi2")))
+  #ifdef __BMI2__
+    #define HAS_BMI2 1
+  #else
+    #define HAS_BMI2 cpu_bmi2
+  #endif
+  #if SLOW_PDEP
+    #define HAS_FAST_PDEP 0
+  #elif defined(__BMI2__)
+    #define HAS_FAST_PDEP 1
+  #else
+    #define HAS_FAST_PDEP cpu_fastPdep
+  #endif
+#else
+  #define CPU_DETECT 0
+  #define HAS_BMI2 0
+  #define HAS_FAST_PDEP 0
+#endif
+
+void cpu_init(void); // also called as part of cbqn_init, including after loading a heap image, as that may have been written on another CPU
+char* cpu_features(void); // space-separated list of the detected extensions that are relevant to CBQN, for display
@@ -1,6 +1,16 @@
 #include "../core.h"
 #include "mut.h"
 #include "each.h"
+#if PARALLEL
+  #include "time.h"
+  #include <unistd.h>
+  #include <signal.h>
+  #include <sys/mman.h>
+  #include <sys/wait.h>
+  #if __APPLE__
+    #include <mach/mach.h>
+  #endif
+#endif
 
 static inline B  mv(B*     p, usz n) { B r = p  [n]; p  [n] = m_f64(0); return r; }
 static inline B hmv(HArr_p p, usz n) { B r = p.a[n]; p.a[n] = m_f64(0); return r; }
@@ -134,3 +144,192 @@ B arith_recd(FC2 f, B w, B x) {
   return withFill(r, asFill(fr));
 }
 #endif
+
+#if PARALLEL
+// Workers are forked processes rather than threads: refcounts and the allocator aren't thread-safe, and a copy-on-write
+// copy of the heap gives each worker its own allocator & refcounts for free. Numbers & characters, which are
+// position-independent, are passed back through a shared result list; arrays of them are written to a temporary file per
+// worker, as records of index, element type, shape & data, and rebuilt here. Anything else makes the whole thing fall back.
+#define PAR_SAMPLE_NS 100000   // time to evaluate cells serially for, to estimate the total cost
+#define PAR_MIN_NS    5000000  // minimum estimated remaining time to fork workers for
+#define PAR_WORKER_NS 2000000  // minimum estimated time per worker
+#define PAR_MAX_WORKERS 64
+STATIC_GLOBAL i32 par_cpus;
+
+typedef struct ParRec { usz i, ia; u8 el; ur rnk; } ParRec; // followed by the shape if rnk>1, then the data
+static bool par_write(FILE* f, usz i, B c) { // write array result c of cell i to f; consumes c
+  if (TI(c,elType)==el_B) c = any_squeeze(c);
+  u8 el = TI(c,elType);
+  bool ok = false;
+  if (el!=el_B) {
+    ParRec h = {.i=i, .ia=IA(c), .el=el, .rnk=RNK(c)};
+    u64 bytes = (((u64)h.ia<<elwBitLog(el))+7)>>3;
+    ok = fwrite(&h, sizeof(h), 1, f)==1
+      && (h.rnk<=1 || fwrite(SH(c), sizeof(usz), h.rnk, f)==h.rnk)
+      && fwrite(tyany_ptr(c), 1, bytes, f)==bytes;
+  }
+  decG(c);
+  return ok;
+}
+static bool par_read(B* r, FILE* f) { // read the records written to f into r
+  rewind(f);
+  ParRec h;
+  while (fread(&h, sizeof(h), 1, f)==1) {
+    Arr* a;
+    void* rp = m_tyarrlbp(&a, elwBitLog(h.el), h.ia, el2t(h.el));
+    r[h.i] = taga(a); // freed by the caller on failure
+    usz* sh = arr_shAlloc(a, h.rnk);
+    if (h.rnk>1 && fread(sh, sizeof(usz), h.rnk, f)!=h.rnk) return false;
+    u64 bytes = (((u64)h.ia<<elwBitLog(h.el))+7)>>3;
+    if (fread(rp, 1, bytes, f)!=bytes) return false;
+  }
+  return feof(f);
+}
+static usz par_eval(B* r, usz s, usz e, ParCellFn cell, void* ctx, FILE* out) { // evaluate cells s≤i<e, writing array results to out if it's non-NULL; returns the index of the first that gave something that can't be passed back, or e
+  for (usz i = s; i < e; i++) {
+    B c = cell(ctx, i);
+    if (isNum(c) || isC32(c) || (isArr(c) && out==NULL)) r[i] = c;
+    else if (!isArr(c)) { dec(c); return i; }
+    else if (!par_write(out, i, c)) return i;
+  }
+  return e;
+}
+static void par_stop(pid_t* ws, usz wn) {
+  for (usz i = 0; i < wn; i++) kill(ws[i], SIGKILL);
+  for (usz i = 0; i < wn; i++) waitpid(ws[i], NULL, 0);
+}
+
+static void par_close(FILE** fs, usz wn) {
+  for (usz i = 0; i < wn; i++) fclose(fs[i]);
+}
+
+static bool par_oneThread(void) { // a fork only copies the calling thread, so a lock another thread held (e.g. in malloc) would stay locked in the worker
+  #if __linux__
+    FILE* f = fopen("/proc/self/status", "r");
+    if (f==NULL) return false;
+    char l[128];
+    long n = 0;
+    while (fgets(l, sizeof(l), f)) if (sscanf(l, "Threads: %ld", &n)==1) break;
+    fclose(f);
+    return n==1;
+  #elif __APPLE__
+    thread_act_array_t ts;
+    mach_msg_type_number_t n;
+    if (task_threads(mach_task_self(), &ts, &n)!=KERN_SUCCESS) return false;
+    for (mach_msg_type_number_t i = 0; i < n; i++) mach_port_deallocate(mach_task_self(), ts[i]);
+    vm_deallocate(mach_task_self(), (vm_address_t)ts, n*sizeof(*ts));
+    return n==1;
+  #else
+    return false;
+  #endif
+}
+
+B* par_cells(usz n, ParCellFn cell, void* ctx) {
+  #if defined(CBQN_SHARED) || CBQN_LIB
+    return NULL; // an embedding process may start threads at any point, and doesn't expect to be forked
+  #endif
+  if (par_cpus==0) {
+    long c = sysconf(_SC_NPROCESSORS_ONLN);
+    par_cpus = c<1? 1 : c>PAR_MAX_WORKERS? PAR_MAX_WORKERS : c;
+  }
+  if (par_cpus<2 || n<PAR_MIN) return NULL;
+  u64 bytes = n*sizeof(B);
+  B* r = mmap(NULL, bytes, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_ANONYMOUS, -1, 0); // zero-filled, i.e. all 0.0, so the whole list can be decremented on failure
+  if (r==MAP_FAILED) return NULL;
+  pid_t ws[PAR_MAX_WORKERS];
+  FILE* fs[PAR_MAX_WORKERS];
+  volatile usz wn = 0, fn = 0; // running workers & open files; read after CATCH
+  if (CATCH) { // leave the error to be reproduced by the serial evaluation
+    freeThrown();
+    par_stop(ws, wn);
+    par_close(fs, fn);
+    goto fail;
+  }
+  
+  u64 t0 = nsTime();
+  usz s = 0; u64 dt;
+  do { // sample in growing steps, so cheap cells don't pay for a clock read each
+    usz e = s*2+8; if (e>n) e = n;
+    if (par_eval(r, s, e, cell, ctx, NULL)!=e) goto failC;
+    s = e;
+    dt = nsTime()-t0;
+  } while (dt<PAR_SAMPLE_NS && s<n);
+  if (s==n) goto done;
+  
+  u64 est = (u64)((f64)dt/s * (n-s));
+  if (est<PAR_MIN_NS) goto failC;
+  u64 pn = est/PAR_WORKER_NS; // number of parts, including the one done here
+  if (pn>(u64)par_cpus) pn = par_cpus;
+  if (pn<2 || !par_oneThread()) goto failC;
+  
+  usz ps = s + (n-s)/pn; // this process does s≤i<ps
+  fflush(stdout); fflush(stderr);
+  for (usz i = 1; i < pn; i++) {
+    usz ws0 = s + (n-s)*i/pn;
+    usz we0 = s + (n-s)*(i+1)/pn;
+    FILE* f = tmpfile();
+    if (f==NULL) { par_stop(ws, wn); par_close(fs, fn); goto failC; }
+    pid_t p = fork();
+    if (p<0) { fclose(f); par_stop(ws, wn); par_close(fs, fn); goto failC; }
+    if (p==0) { // worker; exits rather than returning, with a nonzero status on failure
+      if (CATCH) _exit(1);
+      _exit(par_eval(r, ws0, we0, cell, ctx, f)==we0 && fflush(f)==0? 0 : 1);
+    }
+    ws[wn] = p; fs[wn] = f; wn++; fn++;
+  }
+  if (par_eval(r, s, ps, cell, ctx, NULL)!=ps) { par_stop(ws, wn); par_close(fs, fn); goto failC; }
+  
+  bool ok = true;
+  for (usz i = 0; i < wn; i++) {
+    int st;
+    if (waitpid(ws[i], &st, 0)!=ws[i] || !WIFEXITED(st) || WEXITSTATUS(st)!=0) ok = false;
+  }
+  wn = 0;
+  for (usz i = 0; i < fn; i++) if (ok && !par_read(r, fs[i])) ok = false;
+  par_close(fs, fn); fn = 0;
+  if (!ok) goto failC;
+  
+  done:
+  popCatch();
+  return r;
+  
+  failC: popCatch();
+  fail:
+  for (usz i = 0; i < n; i++) dec(r[i]);
+  munmap(r, bytes);
+  return NULL;
+}
+void par_free(B* r, usz n) {
+  munmap(r, n*sizeof(B));
+}
+
+typedef struct ParEach { B f, w, x; FC1 fc1; FC2 fc2; } ParEach;
+static B par_eachm_cell (void* c, usz i) { ParEach* p = c; return p->fc1(p->f,                     IGet(p->x,i)); }
+static B par_eachd_cell (void* c, usz i) { ParEach* p = c; return p->fc2(p->f, IGet(p->w,i),       IGet(p->x,i)); }
+static B par_eachdw_cell(void* c, usz i) { ParEach* p = c; return p->fc2(p->f, inc(p->w),          IGet(p->x,i)); }
+static B par_eachdx_cell(void* c, usz i) { ParEach* p = c; return p->fc2(p->f, IGet(p->w,i),       inc(p->x)); }
+static B par_finish(B* rs, B sh) {
+  usz ia = IA(sh);
+  M_HARR(r, ia)
+  for (usz i = 0; i < ia; i++) HARR_ADD(r, i, rs[i]);
+  par_free(rs, ia);
+  return any_squeeze(HARR_FC(r, sh));
+}
+B par_eachm(B f, B x) {
+  if (IA(x)<PAR_MIN || !isFun(f) || !isPureFn(f)) return bi_N;
+  ParEach p = {.f=f, .x=x, .fc1=c1fn(f)};
+  B* rs = par_cells(IA(x), par_eachm_cell, &p);
+  return rs==NULL? bi_N : par_finish(rs, x);
+}
+B par_eachd(B f, B w, B x) {
+  B sh;
+  ParCellFn fn;
+  if (isArr(w) && isArr(x)) { if (!eqShape(w, x) || RNK(x)==0) return bi_N; sh = x; fn = par_eachd_cell; }
+  else if (isArr(x)) { if (RNK(x)==0) return bi_N; sh = x; fn = par_eachdw_cell; }
+  else               { if (RNK(w)==0) return bi_N; sh = w; fn = par_eachdx_cell; }
+  if (IA(sh)<PAR_MIN || !isFun(f) || !isPureFn(f)) return bi_N;
+  ParEach p = {.f=f, .w=w, .x=x, .fc2=c2fn(f)};
+  B* rs = par_cells(IA(sh), fn, &p);
+  return rs==NULL? bi_N : par_finish(rs, sh);
+}
+#endif
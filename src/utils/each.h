@@ -3,6 +3,18 @@
 B eachd_fn(B fo, B w, B x, FC2 f); // consumes w,x; assumes at least one is array
 B eachm_fn(B fo, B x, FC1 f); // consumes x; x must be array
 
+#if PARALLEL
+// Evaluates cell(ctx,i) for 0≤i<n, splitting the work between this process and forked workers if it appears to take long enough to be worth it.
+// The calls must be pure (so they can be re-evaluated & run in any order), and are expected to give numbers, characters, or arrays without nested elements.
+// Returns a list of the n results, which the caller takes ownership of before releasing the list with par_free, or NULL if that wasn't worthwhile, or a call gave anything else or errored; the caller should then evaluate everything serially.
+typedef B (*ParCellFn)(void* ctx, usz i);
+B* par_cells(usz n, ParCellFn cell, void* ctx);
+void par_free(B* r, usz n);
+#define PAR_MIN 1024 // minimum number of cells to attempt parallel evaluation on
+B par_eachm(B f, B x);      // F¨x for pure F; doesn't consume; bi_N if not done
+B par_eachd(B f, B w, B x); // w F¨ x for pure F; doesn't consume; bi_N if not done
+#endif
+
 
 #if SEMANTIC_CATCH
 NOINLINE B arith_recd(FC2 f, B w, B x);
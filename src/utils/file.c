@@ -101,6 +101,25 @@ B path_lines(B path) { // consumes; TODO rewrite this, it's horrible
     }
   }
   if (ia && (p[ia-1]!='\n' && p[ia-1]!='\r')) lineCount++;
+  if (lineCount >= STRLIST_MIN) { // decode everything at once, then move the lines together over the line breaks
+    B chars = utf8Decode((char*)p, ia);
+    ptr_dec(tf);
+    StrList* r = m_strlistp(chars, false, lineCount);
+    usz* off = r->off;
+    usz n = IA(chars);
+    #define CASE(T) { T* cp = tyarr_ptr(chars); \
+      usz i = 0, o = 0;                         \
+      for (usz l = 0; l < lineCount; l++) {     \
+        off[l] = o;                             \
+        while (i<n && cp[i]!='\n' && cp[i]!='\r') cp[o++] = cp[i++]; \
+        if (i<n && cp[i]=='\r' && i+1<n && cp[i+1]=='\n') i+= 2; \
+        else i++;                               \
+      }                                         \
+      off[lineCount] = o; }
+    if (TY(chars)==t_c8arr) CASE(u8) else CASE(u32)
+    #undef CASE
+    return taga(r);
+  }
   M_HARR(r, lineCount)
   usz pos = 0;
   for (usz i = 0; i < lineCount; i++) {
@@ -0,0 +1,56 @@
+#include "../core.h"
+#include "perf.h"
+
+char* const perf_names[PERF_CNT_N] = {"cycles", "instructions", "branchmisses", "l1dmisses", "llcmisses", "pagefaults"};
+
+#if defined(__linux__) && !defined(NO_PERF_COUNTERS)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+STATIC_GLOBAL bool perf_opened;
+STATIC_GLOBAL int perf_fds[PERF_CNT_N];
+
+static void perf_open(void) {
+  perf_opened = true;
+  static const u32 types[PERF_CNT_N] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_SOFTWARE};
+  static const u64 configs[PERF_CNT_N] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ<<8) | (PERF_COUNT_HW_CACHE_RESULT_MISS<<16),
+    PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_SW_PAGE_FAULTS
+  };
+  for (i32 i = 0; i < PERF_CNT_N; i++) {
+    struct perf_event_attr a = {0};
+    a.size = sizeof(a);
+    a.type = types[i];
+    a.config = configs[i];
+    a.exclude_kernel = 1; // allowed at perf_event_paranoid≤2
+    a.exclude_hv = 1;
+    a.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // separate events instead of a group, so that an unsupported one doesn't take the others with it; the kernel multiplexes them if there aren't enough hardware counters
+    perf_fds[i] = syscall(SYS_perf_event_open, &a, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+  }
+}
+
+bool perf_read(PerfCounts* r) {
+  if (!perf_opened) perf_open();
+  bool any = false;
+  for (i32 i = 0; i < PERF_CNT_N; i++) {
+    u64 v[3]; // value, time enabled, time running
+    if (perf_fds[i]<0 || read(perf_fds[i], v, sizeof(v)) != sizeof(v)) { r->c[i] = -1; continue; }
+    r->c[i] = v[2]==0? 0 : v[2]==v[1]? (f64)v[0] : v[0] * ((f64)v[1]/v[2]); // scale up if multiplexed
+    any = true;
+  }
+  return any;
+}
+#else
+bool perf_read(PerfCounts* r) {
+  for (i32 i = 0; i < PERF_CNT_N; i++) r->c[i] = -1;
+  return false;
+}
+#endif
+
+void perf_diff(PerfCounts* r, PerfCounts* s, PerfCounts* e, f64 div) {
+  for (i32 i = 0; i < PERF_CNT_N; i++) r->c[i] = s->c[i]<0 || e->c[i]<0? -1 : e->c[i]<s->c[i]? 0 : (e->c[i]-s->c[i])/div; // scaled values of multiplexed counters can go backwards
+}
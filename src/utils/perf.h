@@ -0,0 +1,9 @@
+#pragma once
+
+// Hardware & OS performance counters of the current thread, via perf_event_open; only available on Linux
+enum PerfCounter { pc_cycles, pc_instructions, pc_branchMisses, pc_l1dMisses, pc_llcMisses, pc_pageFaults, PERF_CNT_N };
+extern char* const perf_names[PERF_CNT_N]; // lowercase names, usable as namespace field names
+typedef struct { f64 c[PERF_CNT_N]; } PerfCounts; // negative for counters that aren't available
+
+bool perf_read(PerfCounts* r); // read the current counter values, starting the counters on the first call; returns false (and fills r with ¯1) if none are available
+void perf_diff(PerfCounts* r, PerfCounts* s, PerfCounts* e, f64 div); // r ← (e-s)÷div for counters available in both
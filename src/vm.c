@@ -21,7 +21,9 @@
                   F(MD2R) F(MD2L) F(VARO) F(VARM) F(VFYM) F(SETH) F(RETN) F(FLDO) F(FLDM) F(ALIM) F(NOTM) F(RETD) F(SYSV) F(VARU) F(PRED) \
                   F(EXTO) F(EXTM) F(EXTU) F(FLDG) F(ADDI) F(ADDU) F(FN1Ci)F(FN1Oi)F(FN2Ci)F(FN2Oi) \
                   F(SETNi)F(SETUi)F(SETMi)F(SETCi)F(SETNv)F(SETUv)F(SETMv)F(SETCv)F(PRED1)F(PRED2)F(SETH1)F(SETH2) \
-                  F(DFND0)F(DFND1)F(DFND2)F(FAIL)
+                  F(DFND0)F(DFND1)F(DFND2)F(FAIL) \
+                  F(VFN1C)F(VFN2C)F(IFN1C)F(IFN2C)F(UFN1C)F(UFN2C)F(IVFN2C)F(IIFN2C)F(IUFN2C)F(MSETN)F(MSETU)F(MSETNV)F(MSETUV)F(VFLDG) \
+                  F(FN1B) F(FN2B) F(FN1K) F(FN2K) F(FN1M) F(FN2M)
 
 
 char* bc_repr(u32 p) {
@@ -88,9 +90,6 @@ void print_gStack() {
 }
 
 B listVars(Scope* sc) {
-  #if ONLY_NATIVE_COMP
-    return emptyHVec();
-  #endif
   Body* b = sc->body;
   if (b==NULL) return bi_N;
   
@@ -142,6 +141,26 @@ typedef struct NextRequest {
 
 STATIC_GLOBAL B emptyARMM;
 
+#if VM_SUPER
+static void bc_fuse(u32* c) { // rewrite common sequences in a body into superinstructions
+  while (*c!=RETN & *c!=RETD) {
+    u32* n = nextBC(c);
+    switch (*c) {
+      case VARO: if (*n==FN1C) *c = VFN1C; else if (*n==FN2C) *c = VFN2C; else if (*n==FLDG) *c = VFLDG; break;
+      case ADDI:
+        if (*n==FN1C) *c = IFN1C; else if (*n==FN2C) *c = IFN2C;
+        else if ((*n==VARO | *n==ADDI | *n==ADDU) && *nextBC(n)==FN2C) *c = *n==VARO? IVFN2C : *n==ADDI? IIFN2C : IUFN2C;
+        break;
+      case ADDU: if (*n==FN1C) *c = UFN1C; else if (*n==FN2C) *c = UFN2C; break;
+      case VARM:
+        if (*n==SETN | *n==SETU) *c = *nextBC(n)==POPS? (*n==SETN? MSETN : MSETU) : (*n==SETN? MSETNV : MSETUV);
+        break;
+    }
+    c = n;
+  }
+}
+#endif
+
 Block* compileBlock(B block, Comp* comp, bool* bDone, u32* bc, usz bcIA, B allBlocks, B allBodies, B nameList, Scope* sc, i32 depth, i32 myPos, i32 nsResult) {
   assert(sc!=NULL || nsResult==0);
   usz blIA = IA(block);
@@ -446,6 +465,9 @@ Block* compileBlock(B block, Comp* comp, bool* bDone, u32* bc, usz bcIA, B allBl
     bl->bodies[i] = bodies[i];
     bodies[i]->bc = (u32*)nbc + bodies[i]->bcTmp;
     bodies[i]->bl = ptr_inc(bl);
+    #if VM_SUPER
+      bc_fuse(bodies[i]->bc);
+    #endif
   }
   TSFREE(bodies);
   return bl;
@@ -701,7 +723,7 @@ FORCE_INLINE B gotoNextBody(Block* bl, Scope* sc, Body* body) {
   assert(sc->psc!=NULL);
   Scope* nsc = m_scopeI(body, sc->psc, body->varAm, ga, sc->vars, true);
   scope_dec(sc);
-  return execBodyInplaceI(body, nsc, bl);
+  return execBodyRawI(body, nsc, bl); // a tail call in the next body is left for the caller of this one to run
 }
 
 #if DEBUG_VM
@@ -710,7 +732,24 @@ i32* vmStack;
 i32 bcCtr = 0;
 #endif
 #define BCPOS(B,P) (B->bl->map[(P)-(u32*)B->bl->bc])
+#define FOR_EVAL_BC(F) F(POPS)F(PUSH)F(ADDI)F(ADDU)F(FN1C)F(FN1O)F(FN2C)F(FN2O)F(LSTO)F(LSTM)F(DFND0)F(DFND1)F(DFND2) \
+  F(MD1C)F(MD2C)F(TR2D)F(TR3D)F(TR3O)F(VARM)F(VARO)F(VARU)F(EXTM)F(EXTO)F(EXTU)F(SETN)F(SETU)F(SETM)F(SETC) \
+  F(SETH1)F(SETH2)F(PRED1)F(PRED2)F(FLDG)F(ALIM)F(CHKV)F(VFYM)F(FAIL)F(ARMO)F(ARMM)F(RETD)F(RETN) \
+  F(VFN1C)F(VFN2C)F(IFN1C)F(IFN2C)F(UFN1C)F(UFN2C)F(IVFN2C)F(IIFN2C)F(IUFN2C)F(MSETN)F(MSETU)F(MSETNV)F(MSETUV)F(VFLDG)F(FN1B)F(FN2B)F(FN1K)F(FN2K)F(FN1M)F(FN2M)
+FORCE_INLINE B execBlock(Block* block, Body* body, Scope* psc, i32 ga, B* svar);
+#if VM_THREADED
+  STATIC_GLOBAL void* bcLabels[BC_SIZE]; // filled by comp_init calling evalBC with b==NULL, as label addresses can only be taken in there
+#endif
 B evalBC(Body* b, Scope* sc, Block* bl) { // doesn't consume
+  #if VM_THREADED
+    if (RARE(b==NULL)) {
+      for (i32 i = 0; i < BC_SIZE; i++) bcLabels[i] = &&bc_default;
+      #define F(X) bcLabels[X] = &&bc_##X;
+      FOR_EVAL_BC(F)
+      #undef F
+      return bi_N;
+    }
+  #endif
   #if DEBUG_VM
     bcDepth+= 2;
     if (!vmStack) vmStack = malloc(400);
@@ -748,6 +787,19 @@ B evalBC(Body* b, Scope* sc, Block* bl) { // doesn't consume
   #else
     #define POS_UPD
   #endif
+  #if VM_TAILCALL // to be used after popping a call's arguments; bc must point at the next instruction
+    #define TAIL_CALL(F,W,X) if (*bc==RETN && !bl->imm && vm_canTailCall(F)) { ADD(vm_setTailCall(F, W, X)); goto end; }
+  #else
+    #define TAIL_CALL(F,W,X) {}
+  #endif
+  
+  #if VM_THREADED
+    #define BC_CASE(X) case X: bc_##X
+    #define BC_DEFAULT default: bc_default
+  #else
+    #define BC_CASE(X) case X
+    #define BC_DEFAULT default
+  #endif
   
   while(true) {
     #if DEBUG_VM
@@ -760,43 +812,58 @@ B evalBC(Body* b, Scope* sc, Block* bl) { // doesn't consume
       bcCtr++;
       for (i32 i = 0; i < sc->varAm; i++) VALIDATE(sc->vars[i]);
     #endif
+    #if VM_THREADED
+      goto *bcLabels[*bc++]; // the switch is only used for its labels; gcc & clang duplicate this jump into the end of every instruction
+    #endif
     switch(*bc++) {
-      case POPS: dec(POP); break;
-      case PUSH: {
+      BC_CASE(POPS): dec(POP); break;
+      BC_CASE(PUSH): {
         ADD(inc(bl->comp->objs->a[*bc++]));
         break;
       }
-      case ADDI: {
+      BC_CASE(ADDI): {
         ADD(incG(b(L64)));
         break;
       }
-      case ADDU: {
+      BC_CASE(ADDU): {
         ADD(b(L64));
         break;
       }
-      case FN1C: { P(f)P(x)
+      BC_CASE(FN1C): { P(f)P(x)
         GS_UPD;POS_UPD;
+        #if VM_QUICKEN
+          bc[-1] = !isFun(f)? FN1M : TY(f)==t_funBI? FN1B : TY(f)==t_funBl? FN1K : FN1M;
+        #endif
+        TAIL_CALL(f, bi_N, x);
         ADD(c1(f, x)); dec(f);
         break;
       }
-      case FN1O: { P(f)P(x)
+      BC_CASE(FN1O): { P(f)P(x)
         GS_UPD;POS_UPD;
+        if (!q_N(x)) TAIL_CALL(f, bi_N, x);
         ADD(q_N(x)? x : c1(f, x)); dec(f);
         break;
       }
-      case FN2C: { P(w)P(f)P(x)
+      BC_CASE(FN2C): { P(w)P(f)P(x)
         GS_UPD;POS_UPD;
+        #if VM_QUICKEN
+          bc[-1] = !isFun(f)? FN2M : TY(f)==t_funBI? FN2B : TY(f)==t_funBl? FN2K : FN2M;
+        #endif
+        TAIL_CALL(f, w, x);
         ADD(c2(f, w, x)); dec(f);
         break;
       }
-      case FN2O: { P(w)P(f)P(x)
+      BC_CASE(FN2O): { P(w)P(f)P(x)
         GS_UPD;POS_UPD;
         if (q_N(x)) { dec(w); ADD(x); }
-        else ADD(q_N(w)? c1(f, x) : c2(f, w, x));
+        else {
+          TAIL_CALL(f, w, x); // a · 𝕨 is left as bi_N, making it a monadic call
+          ADD(q_N(w)? c1(f, x) : c2(f, w, x));
+        }
         dec(f);
         break;
       }
-      case LSTO: case LSTM: { GS_UPD;
+      BC_CASE(LSTO): BC_CASE(LSTM): { GS_UPD;
         u32 sz = *bc++;
         if (sz==0) {
           ADD(emptyHVec());
@@ -812,64 +879,64 @@ B evalBC(Body* b, Scope* sc, Block* bl) { // doesn't consume
         }
         break;
       }
-      case DFND0: { GS_UPD;POS_UPD; ADD(evalFunBlock(TOPTR(Block,L64), sc)); break; }
-      case DFND1: { GS_UPD;POS_UPD; ADD(m_md1Block  (TOPTR(Block,L64), sc)); break; }
-      case DFND2: { GS_UPD;POS_UPD; ADD(m_md2Block  (TOPTR(Block,L64), sc)); break; }
+      BC_CASE(DFND0): { GS_UPD;POS_UPD; ADD(evalFunBlock(TOPTR(Block,L64), sc)); break; }
+      BC_CASE(DFND1): { GS_UPD;POS_UPD; ADD(m_md1Block  (TOPTR(Block,L64), sc)); break; }
+      BC_CASE(DFND2): { GS_UPD;POS_UPD; ADD(m_md2Block  (TOPTR(Block,L64), sc)); break; }
       
-      case MD1C: { P(f)P(m)     GS_UPD;POS_UPD; ADD(m1_d  (m,f  )); break; }
-      case MD2C: { P(f)P(m)P(g) GS_UPD;POS_UPD; ADD(m2_d  (m,f,g)); break; }
-      case TR2D: {     P(g)P(h) GS_UPD;         ADD(m_atop(  g,h)); break; }
-      case TR3D: { P(f)P(g)P(h) GS_UPD;         ADD(m_fork(f,g,h)); break; }
-      case TR3O: { P(f)P(g)P(h) GS_UPD;
+      BC_CASE(MD1C): { P(f)P(m)     GS_UPD;POS_UPD; ADD(m1_d  (m,f  )); break; }
+      BC_CASE(MD2C): { P(f)P(m)P(g) GS_UPD;POS_UPD; ADD(m2_d  (m,f,g)); break; }
+      BC_CASE(TR2D): {     P(g)P(h) GS_UPD;         ADD(m_atop(  g,h)); break; }
+      BC_CASE(TR3D): { P(f)P(g)P(h) GS_UPD;         ADD(m_fork(f,g,h)); break; }
+      BC_CASE(TR3O): { P(f)P(g)P(h) GS_UPD;
         if (q_N(f)) { ADD(m_atop(g,h)); dec(f); }
         else ADD(m_fork(f,g,h));
         break;
       }
       
-      case VARM: { u32 d = *bc++; u32 p = *bc++;
+      BC_CASE(VARM): { u32 d = *bc++; u32 p = *bc++;
         ADD(tagu64((u64)d<<32 | (u32)p, VAR_TAG));
         break;
       }
-      case VARO: { u32 d = *bc++; u32 p = *bc++;
+      BC_CASE(VARO): { u32 d = *bc++; u32 p = *bc++;
         B l = pscs[d]->vars[p];
         if(v_checkBadRead(l)) { POS_UPD; v_tagError(l, false); }
         ADD(inc(l));
         break;
       }
-      case VARU: { u32 d = *bc++; u32 p = *bc++;
+      BC_CASE(VARU): { u32 d = *bc++; u32 p = *bc++;
         B* vars = pscs[d]->vars;
         ADD(vars[p]);
         vars[p] = bi_optOut;
         break;
       }
       
-      case EXTM: { u32 d = *bc++; u32 p = *bc++;
+      BC_CASE(EXTM): { u32 d = *bc++; u32 p = *bc++;
         ADD(tagu64((u64)d<<32 | (u32)p, EXT_TAG));
         break;
       }
-      case EXTO: { u32 d = *bc++; u32 p = *bc++;
+      BC_CASE(EXTO): { u32 d = *bc++; u32 p = *bc++;
         B l = pscs[d]->ext->vars[p];
         if(v_checkBadRead(l)) { POS_UPD; v_tagError(l, false); }
         ADD(inc(l));
         break;
       }
-      case EXTU: { u32 d = *bc++; u32 p = *bc++;
+      BC_CASE(EXTU): { u32 d = *bc++; u32 p = *bc++;
         B* vars = pscs[d]->ext->vars;
         ADD(vars[p]);
         vars[p] = bi_optOut;
         break;
       }
       
-      case SETN: { P(s)    P(x) GS_UPD; POS_UPD; v_set(pscs, s, x, false, true, true, false); ADD(x); break; }
-      case SETU: { P(s)    P(x) GS_UPD; POS_UPD; v_set(pscs, s, x, true,  true, true, false); ADD(x); break; }
-      case SETM: { P(s)P(f)P(x) GS_UPD; POS_UPD;
+      BC_CASE(SETN): { P(s)    P(x) GS_UPD; POS_UPD; v_set(pscs, s, x, false, true, true, false); ADD(x); break; }
+      BC_CASE(SETU): { P(s)    P(x) GS_UPD; POS_UPD; v_set(pscs, s, x, true,  true, true, false); ADD(x); break; }
+      BC_CASE(SETM): { P(s)P(f)P(x) GS_UPD; POS_UPD;
         B w = v_get(pscs, s, true);
         B r = c2(f,w,x); dec(f);
         v_set(pscs, s, r, true, false, true, false);
         ADD(r);
         break;
       }
-      case SETC: { P(s)P(f) GS_UPD; POS_UPD;
+      BC_CASE(SETC): { P(s)P(f) GS_UPD; POS_UPD;
         B x = v_get(pscs, s, true);
         B r = c1(f,x); dec(f);
         v_set(pscs, s, r, true, false, true, false);
@@ -877,50 +944,50 @@ B evalBC(Body* b, Scope* sc, Block* bl) { // doesn't consume
         break;
       }
       
-      case SETH1:{ P(s)    P(x) GS_UPD; POS_UPD; u64 v1 = L64;
+      BC_CASE(SETH1):{ P(s)    P(x) GS_UPD; POS_UPD; u64 v1 = L64;
         bool ok = v_seth(pscs, s, x); dec(x); dec(s);
         if (!ok) { return gotoNextBody(bl, sc, TOPTR(Body, v1)); }
         break;
       }
-      case SETH2:{ P(s)    P(x) GS_UPD; POS_UPD; u64 v1 = L64; u64 v2 = L64;
+      BC_CASE(SETH2):{ P(s)    P(x) GS_UPD; POS_UPD; u64 v1 = L64; u64 v2 = L64;
         bool ok = v_seth(pscs, s, x); dec(x); dec(s);
         if (!ok) { return gotoNextBody(bl, sc, TOPTR(Body, q_N(sc->vars[2])? v1 : v2)); }
         break;
       }
-      case PRED1:{ P(x) GS_UPD; POS_UPD; u64 v1 = L64;
+      BC_CASE(PRED1):{ P(x) GS_UPD; POS_UPD; u64 v1 = L64;
         if (!o2b(x)) { return gotoNextBody(bl, sc, TOPTR(Body, v1)); }
         break;
       }
-      case PRED2:{ P(x) GS_UPD; POS_UPD; u64 v1 = L64; u64 v2 = L64;
+      BC_CASE(PRED2):{ P(x) GS_UPD; POS_UPD; u64 v1 = L64; u64 v2 = L64;
         if (!o2b(x)) { return gotoNextBody(bl, sc, TOPTR(Body, q_N(sc->vars[2])? v1 : v2)); }
         break;
       }
       
-      case FLDG: { P(ns) GS_UPD; u32 p = *bc++; POS_UPD;
+      BC_CASE(FLDG): { P(ns) GS_UPD; u32 p = *bc++; POS_UPD;
         if (!isNsp(ns)) thrM("Trying to read a field from non-namespace");
         ADD(inc(ns_getU(ns, p)));
         dec(ns);
         break;
       }
-      case ALIM: { P(o) GS_UPD; u32 l = *bc++;
+      BC_CASE(ALIM): { P(o) GS_UPD; u32 l = *bc++;
         FldAlias* a = mm_alloc(sizeof(FldAlias), t_fldAlias);
         a->obj = o;
         a->p = l;
         ADD(tag(a,OBJ_TAG));
         break;
       }
-      case CHKV: {
+      BC_CASE(CHKV): {
         if (q_N(PEEK(1))) { GS_UPD; POS_UPD; thrM("Unexpected Nothing (·)"); }
         break;
       }
-      case VFYM: { P(o) GS_UPD;
+      BC_CASE(VFYM): { P(o) GS_UPD;
         WrappedObj* a = mm_alloc(sizeof(WrappedObj), t_vfyObj);
         a->obj = o;
         ADD(tag(a,OBJ_TAG));
         break;
       }
-      case FAIL: thrM(q_N(sc->vars[2])? "This block cannot be called monadically" : "This block cannot be called dyadically");
-      case ARMO: { GS_UPD;
+      BC_CASE(FAIL): thrM(q_N(sc->vars[2])? "This block cannot be called monadically" : "This block cannot be called dyadically");
+      BC_CASE(ARMO): { GS_UPD;
         POS_UPD;
         u32 sz = *bc++;
         assert(sz>0);
@@ -930,7 +997,7 @@ B evalBC(Body* b, Scope* sc, Block* bl) { // doesn't consume
         ADD(bqn_merge(r.b, 2));
         break;
       }
-      case ARMM: { GS_UPD;
+      BC_CASE(ARMM): { GS_UPD;
         u32 sz = *bc++;
         assert(sz>0);
         HArr_p r = m_harrUv(sz);
@@ -942,13 +1009,134 @@ B evalBC(Body* b, Scope* sc, Block* bl) { // doesn't consume
         break;
       }
       
-      case RETD: { GS_UPD;
+      // superinstructions; the POS_UPDs in them are placed such that bc-1 is within the instruction that may error
+      BC_CASE(VFN1C): { u32 d = *bc++; u32 p = *bc++;
+        B f = pscs[d]->vars[p];
+        if(v_checkBadRead(f)) { POS_UPD; v_tagError(f, false); }
+        inc(f); bc++; P(x)
+        GS_UPD;POS_UPD;
+        TAIL_CALL(f, bi_N, x);
+        ADD(c1(f, x)); dec(f);
+        break;
+      }
+      BC_CASE(VFN2C): { u32 d = *bc++; u32 p = *bc++;
+        B w = pscs[d]->vars[p];
+        if(v_checkBadRead(w)) { POS_UPD; v_tagError(w, false); }
+        inc(w); bc++; P(f)P(x)
+        GS_UPD;POS_UPD;
+        TAIL_CALL(f, w, x);
+        ADD(c2(f, w, x)); dec(f);
+        break;
+      }
+      BC_CASE(IFN1C): BC_CASE(UFN1C): { B f = b(L64); bc++; P(x) // f is kept alive by the block's objects
+        GS_UPD;POS_UPD;
+        ADD(c1(f, x));
+        break;
+      }
+      BC_CASE(IFN2C): { B w = incG(b(L64)); bc++; P(f)P(x)
+        GS_UPD;POS_UPD;
+        TAIL_CALL(f, w, x);
+        ADD(c2(f, w, x)); dec(f);
+        break;
+      }
+      BC_CASE(UFN2C): { B w = b(L64); bc++; P(f)P(x)
+        GS_UPD;POS_UPD;
+        TAIL_CALL(f, w, x);
+        ADD(c2(f, w, x)); dec(f);
+        break;
+      }
+      BC_CASE(IVFN2C): { B f = b(L64); bc++; u32 d = *bc++; u32 p = *bc++; // f is kept alive by the block's objects
+        B w = pscs[d]->vars[p];
+        if(v_checkBadRead(w)) { POS_UPD; v_tagError(w, false); }
+        inc(w); bc++; P(x)
+        GS_UPD;POS_UPD;
+        ADD(c2(f, w, x));
+        break;
+      }
+      BC_CASE(IIFN2C): { B f = b(L64); bc++; B w = incG(b(L64)); bc++; P(x)
+        GS_UPD;POS_UPD;
+        ADD(c2(f, w, x));
+        break;
+      }
+      BC_CASE(IUFN2C): { B f = b(L64); bc++; B w = b(L64); bc++; P(x)
+        GS_UPD;POS_UPD;
+        ADD(c2(f, w, x));
+        break;
+      }
+      BC_CASE(MSETN): { u32 d = *bc++; u32 p = *bc++; bc+= 2; P(x) GS_UPD;
+        v_setI(pscs[d], p, x, false, true);
+        break;
+      }
+      BC_CASE(MSETU): { u32 d = *bc++; u32 p = *bc++; bc++; P(x) GS_UPD; POS_UPD; bc++;
+        v_setI(pscs[d], p, x, true, true);
+        break;
+      }
+      BC_CASE(MSETNV): { u32 d = *bc++; u32 p = *bc++; bc++; GS_UPD;
+        v_setI(pscs[d], p, inc(PEEK(1)), false, true);
+        break;
+      }
+      BC_CASE(MSETUV): { u32 d = *bc++; u32 p = *bc++; bc++; GS_UPD; POS_UPD;
+        v_setI(pscs[d], p, inc(PEEK(1)), true, true);
+        break;
+      }
+      BC_CASE(VFLDG): { u32 d = *bc++; u32 p = *bc++;
+        B ns = pscs[d]->vars[p];
+        if(v_checkBadRead(ns)) { POS_UPD; v_tagError(ns, false); }
+        bc++; u32 fp = *bc++; GS_UPD; POS_UPD;
+        if (!isNsp(ns)) thrM("Trying to read a field from non-namespace");
+        ADD(inc(ns_getU(ns, fp)));
+        break;
+      }
+      
+      // quickened calls; on a guard failure, the instruction is turned into FN1M/FN2M and the call done the generic way
+      BC_CASE(FN1B): { P(f)P(x)
+        GS_UPD;POS_UPD;
+        if (RARE(!isFun(f) || TY(f)!=t_funBI)) { bc[-1] = FN1M; ADD(c1(f, x)); dec(f); break; }
+        ADD(VALIDATE(c1G(f, x))); dec(f);
+        break;
+      }
+      BC_CASE(FN2B): { P(w)P(f)P(x)
+        GS_UPD;POS_UPD;
+        if (RARE(!isFun(f) || TY(f)!=t_funBI)) { bc[-1] = FN2M; ADD(c2(f, w, x)); dec(f); break; }
+        ADD(VALIDATE(c2G(f, w, x))); dec(f);
+        break;
+      }
+      BC_CASE(FN1K): { P(f)P(x)
+        GS_UPD;POS_UPD;
+        if (RARE(!isFun(f) || TY(f)!=t_funBl)) { bc[-1] = FN1M; ADD(c1(f, x)); dec(f); break; }
+        TAIL_CALL(f, bi_N, x);
+        FunBlock* fb = c(FunBlock, f); // the reference to f is moved into 𝕊 instead of being incremented by funBl_c1
+        ADD(execBlock(fb->bl, fb->bl->bodies[0], fb->sc, 3, (B[]){f, x, bi_N}));
+        break;
+      }
+      BC_CASE(FN2K): { P(w)P(f)P(x)
+        GS_UPD;POS_UPD;
+        if (RARE(!isFun(f) || TY(f)!=t_funBl)) { bc[-1] = FN2M; ADD(c2(f, w, x)); dec(f); break; }
+        TAIL_CALL(f, w, x);
+        FunBlock* fb = c(FunBlock, f);
+        ADD(execBlock(fb->bl, fb->bl->dyBody, fb->sc, 3, (B[]){f, x, w}));
+        break;
+      }
+      BC_CASE(FN1M): { P(f)P(x)
+        GS_UPD;POS_UPD;
+        TAIL_CALL(f, bi_N, x);
+        ADD(c1(f, x)); dec(f);
+        break;
+      }
+      BC_CASE(FN2M): { P(w)P(f)P(x)
+        GS_UPD;POS_UPD;
+        TAIL_CALL(f, w, x);
+        ADD(c2(f, w, x)); dec(f);
+        break;
+      }
+      
+      BC_CASE(RETD): { GS_UPD;
         ADD(m_ns(ptr_inc(sc), ptr_inc(b->nsDesc)));
         goto end;
       }
-      case RETN: goto end;
+      BC_CASE(RETN): goto end;
       
-      default:
+      BC_DEFAULT:
         #if DEBUG
           printf("todo %d\n", bc[-1]); bc++; break;
         #else
@@ -970,18 +1158,47 @@ B evalBC(Body* b, Scope* sc, Block* bl) { // doesn't consume
   popEnv();
   scope_dec(sc);
   return r;
+  #undef BC_CASE
+  #undef BC_DEFAULT
   #undef L64
   #undef P
   #undef ADD
   #undef POP
   #undef POS_UPD
   #undef GS_UPD
+  #undef TAIL_CALL
 }
 
 NOINLINE Scope* m_scope(Body* body, Scope* psc, u16 varAm, i32 initVarAm, B* initVars) { // consumes initVarAm items of initVars
   return m_scopeI(body, psc, varAm, initVarAm, initVars, false);
 }
 
+GLOBAL TailCall vm_tailCall;
+NOINLINE B vm_runTailCalls(void) { // run the call stored in vm_tailCall, and any that it in turn ends in, in constant C stack space
+  B r;
+  do {
+    TailCall t = vm_tailCall;
+    CHECK_INTERRUPT;
+    B vars[6] = {t.f, t.x, t.w}; // the reference to f is moved into 𝕤 instead of being incremented as in funBl_c1 & co
+    Block* bl; Scope* psc; i32 ga;
+    switch (TY(t.f)) { default: UD;
+      case t_funBl: { FunBlock* b = c(FunBlock, t.f); bl = b->bl; psc = b->sc; ga = 3; break; }
+      case t_md1D: { Md1D* d = c(Md1D, t.f); Md1Block* b = (Md1Block*)d->m1; bl = b->bl; psc = b->sc; ga = 5;
+        vars[3] = tag(ptr_inc(d->m1),MD1_TAG); vars[4] = inc(d->f);
+        break;
+      }
+      case t_md2D: { Md2D* d = c(Md2D, t.f); Md2Block* b = (Md2Block*)d->m2; bl = b->bl; psc = b->sc; ga = 6;
+        vars[3] = tag(ptr_inc(d->m2),MD2_TAG); vars[4] = inc(d->f); vars[5] = inc(d->g);
+        break;
+      }
+    }
+    Body* body = q_N(t.w)? bl->bodies[0] : bl->dyBody;
+    Scope* sc = m_scopeI(body, psc, body->varAm, ga, vars, true);
+    r = execBodyRawI(body, sc, bl);
+  } while (r.u == bi_tailCall.u);
+  return r;
+}
+
 B execBlockInplaceImpl(Body* body, Scope* sc, Block* block) { return execBodyInplaceI(block->bodies[0], sc, block); }
 
 #if JIT_START != -1
@@ -1206,7 +1423,7 @@ GLOBAL B oomMessage;
 
 
 u32 const bL_m[BC_SIZE] = { // bytecode length map
-  [FN1C]=1, [FN2C]=1, [FN1O]=1, [FN2O]=1,
+  [FN1C]=1, [FN2C]=1, [FN1O]=1, [FN2O]=1, [FN1B]=1, [FN2B]=1, [FN1K]=1, [FN2K]=1, [FN1M]=1, [FN2M]=1,
   [MD1C]=1, [MD2C]=1, [MD2R]=1,
   [TR2D]=1, [TR3D]=1, [TR3O]=1,
   [SETN]=1, [SETU]=1, [SETM]=1, [SETH]=1, [SETC]=1,
@@ -1220,6 +1437,8 @@ u32 const bL_m[BC_SIZE] = { // bytecode length map
   [VARO]=3, [VARM]=3, [VARU]=3,
   [EXTO]=3, [EXTM]=3, [EXTU]=3,
   [ADDI]=3, [ADDU]=3,
+  [VFN1C]=3, [VFN2C]=3, [IFN1C]=3, [IFN2C]=3, [UFN1C]=3, [UFN2C]=3, [IVFN2C]=3, [IIFN2C]=3, [IUFN2C]=3,
+  [MSETN]=3, [MSETU]=3, [MSETNV]=3, [MSETUV]=3, [VFLDG]=3,
   [FN1Ci]=3, [FN1Oi]=3, [FN2Ci]=3, [DFND0]=3, [DFND1]=3, [DFND2]=3,
   [SETNi]=3, [SETUi]=3, [SETMi]=3, [SETCi]=3,
   [SETNv]=3, [SETUv]=3, [SETMv]=3, [SETCv]=3, [PRED1]=3, [SETH1]=3,
@@ -1229,9 +1448,11 @@ u32 const bL_m[BC_SIZE] = { // bytecode length map
 i32 const sD_m[BC_SIZE] = { // stack diff map
   [PUSH ]= 1, [DYNO ]= 1, [DYNM]= 1, [DFND]= 1, [VARO]= 1, [VARM]= 1, [DFND0]= 1, [DFND1]=1, [DFND2]=1,
   [VARU ]= 1, [EXTO ]= 1, [EXTM]= 1, [EXTU]= 1, [SYSV]= 1, [ADDI]= 1, [ADDU ]= 1, [NOTM ]= 1,
+  [VFN1C]= 1, [VFN2C]= 1, [IFN1C]= 1, [IFN2C]= 1, [UFN1C]= 1, [UFN2C]= 1, [IVFN2C]= 1, [IIFN2C]= 1, [IUFN2C]= 1,
+  [MSETN]= 1, [MSETU]= 1, [MSETNV]= 1, [MSETUV]= 1, [VFLDG]= 1,
   [FN1Ci]= 0, [FN1Oi]= 0, [CHKV]= 0, [VFYM]= 0, [FLDO]= 0, [FLDG]= 0, [FLDM]= 0, [RETD ]= 0, [ALIM ]=0,
-  [FN2Ci]=-1, [FN2Oi]=-1, [FN1C]=-1, [FN1O]=-1, [MD1C]=-1, [TR2D]=-1, [POPS ]=-1, [MD2R ]=-1, [RETN]=-1, [PRED]=-1, [PRED1]=-1, [PRED2]=-1,
-  [MD2C ]=-2, [TR3D ]=-2, [FN2C]=-2, [FN2O]=-2, [TR3O]=-2, [SETH]=-2, [SETH1]=-2, [SETH2]=-2,
+  [FN2Ci]=-1, [FN2Oi]=-1, [FN1C]=-1, [FN1O]=-1, [FN1B]=-1, [FN1K]=-1, [FN1M]=-1, [MD1C]=-1, [TR2D]=-1, [POPS ]=-1, [MD2R ]=-1, [RETN]=-1, [PRED]=-1, [PRED1]=-1, [PRED2]=-1,
+  [MD2C ]=-2, [TR3D ]=-2, [FN2C]=-2, [FN2O]=-2, [FN2B]=-2, [FN2K]=-2, [FN2M]=-2, [TR3O]=-2, [SETH]=-2, [SETH1]=-2, [SETH2]=-2,
   
   [SETN]=-1, [SETNi]= 0, [SETNv]=-1,
   [SETU]=-1, [SETUi]= 0, [SETUv]=-1,
@@ -1243,11 +1464,13 @@ i32 const sD_m[BC_SIZE] = { // stack diff map
 i32 const sC_m[BC_SIZE] = { // stack consumed map
   [PUSH]=0, [DYNO]=0, [DYNM]=0, [DFND]=0, [VARO ]=0,[VARM ]=0,[NOTM ]=0, [VARU]=0, [EXTO]=0, [EXTM]=0,
   [EXTU]=0, [SYSV]=0, [ADDI]=0, [ADDU]=0, [DFND0]=0,[DFND1]=0,[DFND2]=0,
+  [VFN1C]=0,[VFN2C]=0,[IFN1C]=0,[IFN2C]=0,[UFN1C]=0,[UFN2C]=0,[IVFN2C]=0,[IIFN2C]=0,[IUFN2C]=0,
+  [MSETN]=0,[MSETU]=0,[MSETNV]=0,[MSETUV]=0,[VFLDG]=0,
   
   [CHKV ]=0,[RETD ]=0,
   [FN1Ci]=1,[FN1Oi]=1, [FLDO]=1, [FLDG]=1, [FLDM]=1, [ALIM]=1, [RETN]=1, [POPS]=1, [PRED]=1, [PRED1]=1, [PRED2]=1, [VFYM]=1,
-  [FN2Ci]=2,[FN2Oi]=2, [FN1C]=2, [FN1O]=2, [MD1C]=2, [TR2D]=2, [MD2R]=2, [SETH]=2, [SETH1]=2, [SETH2]=2,
-  [MD2C ]=3,[TR3D ]=3, [FN2C]=3, [FN2O]=3, [TR3O]=3,
+  [FN2Ci]=2,[FN2Oi]=2, [FN1C]=2, [FN1O]=2, [FN1B]=2, [FN1K]=2, [FN1M]=2, [MD1C]=2, [TR2D]=2, [MD2R]=2, [SETH]=2, [SETH1]=2, [SETH2]=2,
+  [MD2C ]=3,[TR3D ]=3, [FN2C]=3, [FN2O]=3, [FN2B]=3, [FN2K]=3, [FN2M]=3, [TR3O]=3,
   
   [SETN]=2, [SETNi]=1, [SETNv]=1,
   [SETU]=2, [SETUi]=1, [SETUv]=1,
@@ -1257,6 +1480,7 @@ i32 const sC_m[BC_SIZE] = { // stack consumed map
   [FAIL]=0
 };
 INIT_GLOBAL i32 sA_m[BC_SIZE]; // stack added map
+INIT_GLOBAL u32 bB_m[BC_SIZE]; // bytecode base map
 
 B funBl_uc1(B t, B o, B x) {
   return funBl_im(t, c1(o, c1(t, x)));
@@ -1297,6 +1521,17 @@ void comp_init(void) {
   for (i32 i = 0; i < BC_SIZE; i++) sA_m[i] = sD_m[i] + sC_m[i];
   sA_m[LSTO]=1; sA_m[ARMO]=1;
   sA_m[LSTM]=1; sA_m[ARMM]=1;
+  
+  for (i32 i = 0; i < BC_SIZE; i++) bB_m[i] = i;
+  bB_m[VFN1C]=VARO; bB_m[VFN2C]=VARO; bB_m[VFLDG]=VARO;
+  bB_m[IFN1C]=ADDI; bB_m[IFN2C]=ADDI; bB_m[IVFN2C]=ADDI; bB_m[IIFN2C]=ADDI; bB_m[IUFN2C]=ADDI;
+  bB_m[UFN1C]=ADDU; bB_m[UFN2C]=ADDU;
+  bB_m[MSETN]=VARM; bB_m[MSETU]=VARM; bB_m[MSETNV]=VARM; bB_m[MSETUV]=VARM;
+  bB_m[FN1B]=FN1C; bB_m[FN1K]=FN1C; bB_m[FN1M]=FN1C;
+  bB_m[FN2B]=FN2C; bB_m[FN2K]=FN2C; bB_m[FN2M]=FN2C;
+  #if VM_THREADED
+    evalBC(NULL, NULL, NULL);
+  #endif
 }
 
 
@@ -1334,6 +1569,38 @@ void popCatch() {
 }
 #endif
 
+#if HEAP_IMAGE
+void vm_imageRestore() { // the stacks aren't part of a heap image, and were empty when it was written
+  #ifdef GS_REALLOC
+    gStack = gStackStart = gStackEnd = NULL;
+  #else
+    allocStack((void**)&gStack, (void**)&gStackStart, (void**)&gStackEnd, sizeof(B), GS_SIZE);
+  #endif
+  allocStack((void**)&envCurr, (void**)&envStart, (void**)&envEnd, sizeof(Env), ENV_SIZE);
+  envCurr--;
+  cf = cfStart = cfEnd = NULL;
+}
+#endif
+
+#if MULTI_INSTANCE
+static void freeStack(void* start, void* end) {
+  #if NO_MMAP
+    free(start);
+  #else
+    munmap(start, (char*)end-(char*)start + getPageSize());
+  #endif
+}
+void vm_freeStacks() { // for discarding an interpreter instance
+  #ifdef GS_REALLOC
+    free(gStackStart);
+  #else
+    freeStack(gStackStart, gStackEnd);
+  #endif
+  freeStack(envStart, envEnd);
+  free(cfStart);
+}
+#endif
+
 extern GLOBAL B replName; // from main.c
 NOINLINE B vm_fmtPoint(B src, B prepend, B path, usz cs, usz ce) { // consumes prepend
   SGetU(src)
@@ -1671,6 +1938,161 @@ usz profiler_getResults(B* compListRes, B* mapListRes, u64 specialResults[], boo
 void profiler_displayResults() { thrM("Profiler not supported"); }
 #endif
 
+#if ALLOC_SITES
+typedef struct AllocSite { Comp* comp; usz cs; } AllocSite; // cs is the source index the site starts at
+GLOBAL u32 allocSites_period;
+STATIC_GLOBAL u32 allocSites_left;
+STATIC_GLOBAL AllocSite* allocSites; // allocSites[0] is unused, as site 0 means unknown; NULL while not recording
+STATIC_GLOBAL u32 allocSites_len, allocSites_cap;
+STATIC_GLOBAL u32 allocSites_free; // unused entries (comp==NULL) form a list through cs, ending with 0
+STATIC_GLOBAL u32 allocSites_base; // site i of the table is stored in objects as allocSites_base+i, so that ones from an earlier recording are unknown
+STATIC_GLOBAL u32* allocSites_map; // open-addressed hash table of indices into allocSites, 0 for an empty slot
+STATIC_GLOBAL u32 allocSites_mapSz;
+
+static u32 allocSites_hash(Comp* comp, usz cs) {
+  return (u32)(((ptr2u64(comp) ^ (u64)cs<<40) * 0x9E3779B97F4A7C15ull) >> 32) & (allocSites_mapSz-1);
+}
+static void allocSites_rehash(u32 sz) {
+  free(allocSites_map);
+  allocSites_map = calloc(sz, sizeof(u32));
+  allocSites_mapSz = sz;
+  for (u32 i = 1; i < allocSites_len; i++) {
+    if (allocSites[i].comp==NULL) continue;
+    u32 p = allocSites_hash(allocSites[i].comp, allocSites[i].cs);
+    while (allocSites_map[p]) p = (p+1) & (sz-1);
+    allocSites_map[p] = i;
+  }
+}
+static void allocSites_gcFn(void) {
+  for (u32 i = 1; i < allocSites_len; i++) if (allocSites[i].comp!=NULL) mm_visitP(allocSites[i].comp);
+}
+
+NOINLINE u32 allocSites_sample(void) { // doesn't allocate on the BQN heap, as it's called from within the allocator
+  if (--allocSites_left) return 0;
+  allocSites_left = allocSites_period;
+  if (envCurr<envStart || gc_running) return 0;
+  Env e = *envCurr;
+  Body* body = e.sc->body;
+  Comp* comp = body->bl->comp;
+  if (q_N(comp->src) || q_N(comp->indices)) return 0; // e.g. precompiled bytecode loaded without source
+  u32 bcPos = e.pos&1? ((u32)e.pos)>>1 : BCPOS(body, TOPTR(u32, e.pos));
+  usz cs = o2s(IGetU(IGetU(comp->indices, 0), bcPos));
+  
+  u32 p = allocSites_hash(comp, cs);
+  while (true) {
+    u32 i = allocSites_map[p];
+    if (i==0) break;
+    if (allocSites[i].comp==comp && allocSites[i].cs==cs) return allocSites_base+i;
+    p = (p+1) & (allocSites_mapSz-1);
+  }
+  u32 i;
+  if (allocSites_free) {
+    i = allocSites_free;
+    allocSites_free = allocSites[i].cs;
+  } else {
+    if (allocSites_len==allocSites_cap) allocSites = realloc(allocSites, (allocSites_cap*=2) * sizeof(AllocSite));
+    i = allocSites_len++;
+  }
+  allocSites[i] = (AllocSite){.comp = ptr_inc(comp), .cs = cs}; // the reference is dropped by a report that finds no objects from this site, or by stopping
+  allocSites_map[p] = i;
+  if (allocSites_len*2 > allocSites_mapSz) allocSites_rehash(allocSites_mapSz*2);
+  return allocSites_base+i;
+}
+static void allocSites_drop(u32 i) { // not from within the allocator, as this can free the compilation
+  Comp* c = allocSites[i].comp;
+  allocSites[i] = (AllocSite){.comp = NULL, .cs = allocSites_free};
+  allocSites_free = i;
+  ptr_dec(c);
+}
+
+STATIC_GLOBAL bool allocSites_gcAdded;
+u32 allocSites_start(u32 period) { // returns the previous period
+  if (period && allocSites==NULL) {
+    allocSites_cap = 64;
+    allocSites = malloc(allocSites_cap * sizeof(AllocSite));
+    allocSites_len = 1;
+    allocSites_free = 0;
+    allocSites_rehash(256);
+    if (!allocSites_gcAdded) { gc_addFn(allocSites_gcFn); allocSites_gcAdded = true; }
+  }
+  if (!period && allocSites!=NULL) { // forget all sites and the compilations they kept alive; objects keep their now-stale site, which allocSites_base makes unknown
+    allocSites_base+= allocSites_len;
+    for (u32 i = 1; i < allocSites_len; i++) if (allocSites[i].comp!=NULL) allocSites_drop(i);
+    free(allocSites); allocSites = NULL;
+    free(allocSites_map); allocSites_map = NULL;
+    allocSites_len = 0;
+  }
+  u32 r = allocSites_period;
+  allocSites_period = allocSites_left = period;
+  return r;
+}
+
+static B allocSites_name(u32 site) {
+  if (site==0) return m_c8vec_0("(unknown)");
+  B src = allocSites[site].comp->src;
+  B path = allocSites[site].comp->fullpath;
+  usz cs = allocSites[site].cs;
+  i64 ln = 1, col = 1;
+  SGetU(src)
+  for (usz i = 0; i < cs; i++) {
+    if (o2cG(GetU(src, i))=='\n') { ln++; col = 1; }
+    else col++;
+  }
+  B s = emptyCVec();
+  if (isArr(path) && IA(path)!=0) AFMT("%R:", path);
+  AFMT("%l:%l", ln, col);
+  return s;
+}
+
+typedef struct AllocSiteRow { u32 site; u8 type; u64 count, bytes; } AllocSiteRow;
+STATIC_GLOBAL u64* allocSites_counts; // count & total size for each site & type
+static void allocSites_countFn(Value* v) {
+  u32 site = v->site - allocSites_base;
+  if (site >= allocSites_len) site = 0; // also catches sites from before allocSites_base, which wrap around
+  u64* c = allocSites_counts + 2*(site*(u64)t_COUNT + PTY(v));
+  c[0]++;
+  c[1]+= mm_size(v);
+}
+static int allocSites_cmp(const void* a, const void* b) {
+  u64 ba = ((AllocSiteRow*)a)->bytes;
+  u64 bb = ((AllocSiteRow*)b)->bytes;
+  return ba<bb? 1 : ba>bb? -1 : 0;
+}
+B allocSites_report(void) { // list of ⟨site, type, count, bytes⟩ for the objects currently on the heap, largest total first
+  if (allocSites==NULL) return emptyHVec();
+  u64 cells = allocSites_len*(u64)t_COUNT;
+  allocSites_counts = calloc(cells*2, sizeof(u64));
+  mm_forHeap(allocSites_countFn);
+  
+  usz n = 0;
+  for (u64 i = 0; i < cells; i++) n+= allocSites_counts[i*2]!=0;
+  u32 sites = allocSites_len; // sites no object is from anymore can be released, so long recordings don't keep every compilation alive
+  for (u32 i = 1; i < sites; i++) {
+    if (allocSites[i].comp==NULL) continue;
+    u64 c = 0;
+    for (u64 j = 0; j < t_COUNT; j++) c|= allocSites_counts[2*(i*(u64)t_COUNT + j)];
+    if (!c) allocSites_drop(i);
+  }
+  allocSites_rehash(allocSites_mapSz);
+  AllocSiteRow* rows = malloc(n*sizeof(AllocSiteRow) + 1);
+  n = 0;
+  for (u64 i = 0; i < cells; i++) {
+    u64* c = allocSites_counts + i*2;
+    if (c[0]) rows[n++] = (AllocSiteRow){.site = i/t_COUNT, .type = i%t_COUNT, .count = c[0], .bytes = c[1]};
+  }
+  free(allocSites_counts);
+  qsort(rows, n, sizeof(AllocSiteRow), allocSites_cmp);
+  
+  M_HARR(r, n);
+  for (usz i = 0; i < n; i++) {
+    AllocSiteRow c = rows[i];
+    HARR_ADD(r, i, m_hvec4(allocSites_name(c.site), m_c8vec_0(type_repr(c.type)), m_f64(c.count), m_f64(c.bytes)));
+  }
+  free(rows);
+  return HARR_FV(r);
+}
+#endif
+
 void unwindEnv(Env* envNew) {
   assert(envNew<=envCurr);
   while (envCurr!=envNew) {
@@ -7,7 +7,7 @@
   (defined(__x86_64) || defined(__amd64__)) \
   && (__APPLE__ || __MACH__ || __linux__ || __FreeBSD__ || __unix || __unix__) \
   && (defined(__linux__)? defined(MAP_FIXED_NOREPLACE) : 1) \
-  && defined(MAP_32BIT) && MM!=0 \
+  && defined(MAP_32BIT) && MM!=0 && !MULTI_INSTANCE \
 )
   #ifndef JIT_START
     #define JIT_START 2 // number of calls for when to start JITting. -1: never JIT; 0: JIT everything, n: JIT after n non-JIT invocations; max ¯1+2⋆16
@@ -16,6 +16,9 @@
   #undef JIT_START
   #define JIT_START -1
 #endif
+#if JIT_START!=-1 && MULTI_INSTANCE
+  #error "MULTI_INSTANCE doesn't support the JIT (compiled code refers to globals by address)"
+#endif
 
 #ifndef EXT_ONLY_GLOBAL
   #define EXT_ONLY_GLOBAL 1
@@ -23,6 +26,22 @@
 #ifndef VM_POS
   #define VM_POS 1
 #endif
+#ifndef VM_THREADED // dispatch evalBC with computed goto instead of a switch
+  #if defined(__GNUC__) && !DEBUG_VM
+    #define VM_THREADED 1
+  #else
+    #define VM_THREADED 0
+  #endif
+#endif
+#ifndef VM_SUPER // rewrite common instruction sequences into superinstructions for evalBC
+  #define VM_SUPER 1
+#endif
+#ifndef VM_QUICKEN // have evalBC rewrite FN1C/FN2C into versions specialized on the kind of function called
+  #define VM_QUICKEN 1
+#endif
+#ifndef VM_TAILCALL // have a block call directly followed by RETN return to the caller's loop instead of nesting, in both evalBC and the JIT
+  #define VM_TAILCALL 1
+#endif
 
 enum {
   PUSH = 0x00, // N; push object from objs[N]
@@ -78,6 +97,18 @@ enum {
   SETH1, SETH2, PRED1, PRED2, // versions of SETH and PRED with 2×u64 arguments (only 1 for PRED1) specifying bodies to jump to on fail (or NULL if is last)
   DFND0, DFND1, DFND2, // internal versions of DFND with a specific type, and a u64 argument representing the block pointer
   FAIL, // this body cannot be called monadically/dyadically
+  // superinstructions; these replace the opcode of the first instruction of a sequence, with the rest left in place, so that
+  // length, stack effect and position info are those of the first instruction, and bcBase gives back its original opcode
+  VFN1C, VFN2C, IFN1C, IFN2C, UFN1C, UFN2C, // VARO/ADDI/ADDU followed by FN1C/FN2C
+  IVFN2C, IIFN2C, IUFN2C, // ADDI of the function, followed by VARO/ADDI/ADDU of 𝕨 and FN2C
+  MSETN, MSETU, // VARM followed by SETN/SETU and POPS
+  MSETNV, MSETUV, // VARM followed by SETN/SETU that keep the value, e.g. the inner assignment of a←b←x
+  VFLDG, // VARO followed by FLDG
+  // quickened calls; evalBC rewrites a FN1C/FN2C in place into one of these based on the first function it calls, and one
+  // whose guard fails into FN1M/FN2M; bcBase gives back FN1C/FN2C
+  FN1B, FN2B, // function was a builtin: call its c1/c2 directly
+  FN1K, FN2K, // function was a block: run its body directly
+  FN1M, FN2M, // function varies: plain call, no longer observed
   BC_SIZE
 };
 
@@ -177,7 +208,7 @@ static B execBlockInplace(Block* block, Scope* sc) { // doesn't consume; execute
 #if JIT_START != -1
 NOINLINE B mnvmExecBodyInplace(Body* body, Scope* sc);
 #endif
-FORCE_INLINE B execBodyInplaceI(Body* body, Scope* sc, Block* block) { // consumes sc, unlike execBlockInplace
+FORCE_INLINE B execBodyRawI(Body* body, Scope* sc, Block* block) { // consumes sc; may return bi_tailCall, so only to be used by something that itself returns into execBodyInplaceI
   #if JIT_START != -1
     if (LIKELY(body->nvm != NULL)) return evalJIT(body, sc, body->nvm);
     bool jit = true;
@@ -190,11 +221,35 @@ FORCE_INLINE B execBodyInplaceI(Body* body, Scope* sc, Block* block) { // consum
   return evalBC(body, sc, block);
 }
 
+// a call of a block function in tail position (FN1C/FN2C or a variant directly followed by RETN) doesn't recurse: the caller's frame
+// is torn down, the call stored here, and bi_tailCall returned, for the nearest execBodyInplaceI to run; the caller thus disappears
+// from stack traces. Bodies of immediate blocks (including whole programs) don't do this, so the top-level position is kept
+typedef struct TailCall { B f, w, x; } TailCall; // f is something vm_canTailCall accepts; w is bi_N for a monadic call
+extern GLOBAL TailCall vm_tailCall;
+NOINLINE B vm_runTailCalls(void);
+static bool vm_canTailCall(B f) { // function blocks, and modifier blocks with operands
+  if (!VM_TAILCALL || !isFun(f)) return false;
+  u8 t = TY(f);
+  return t==t_funBl || (t==t_md1D && PTY(c(Md1D,f)->m1)==t_md1Bl) || (t==t_md2D && PTY(c(Md2D,f)->m2)==t_md2Bl);
+}
+static B vm_setTailCall(B f, B w, B x) { // consumes all
+  vm_tailCall = (TailCall){.f=f, .w=w, .x=x};
+  return bi_tailCall;
+}
+
+FORCE_INLINE B execBodyInplaceI(Body* body, Scope* sc, Block* block) { // consumes sc, unlike execBlockInplace
+  B r = execBodyRawI(body, sc, block);
+  if (RARE(r.u == bi_tailCall.u)) return vm_runTailCalls();
+  return r;
+}
+
 extern u32 const bL_m[BC_SIZE];
 extern i32 const sD_m[BC_SIZE];
 extern i32 const sC_m[BC_SIZE];
 extern INIT_GLOBAL i32 sA_m[BC_SIZE];
+extern INIT_GLOBAL u32 bB_m[BC_SIZE];
 static u32* nextBC       (u32* p) { return p + bL_m[*p]; }
+static u32  bcBase       (u32  p) { return bB_m[p]; } // opcode a superinstruction or quickened call was made from; identity for other opcodes
 static i32  stackAdded   (u32* p) { return sA_m[*p]; }
 static i32  stackDiff    (u32* p) { if (*p==LSTO|*p==LSTM|*p==ARMO|*p==ARMM) return 1-p[1]; return sD_m[*p]; }
 static i32  stackConsumed(u32* p) { if (*p==LSTO|*p==LSTM|*p==ARMO|*p==ARMM) return   p[1]; return sC_m[*p]; }
@@ -209,6 +264,8 @@ typedef struct Md2Block { struct Md2; Scope* sc; Block* bl; } Md2Block;
 B evalFunBlock(Block* bl, Scope* psc); // may return evaluated result, so not named m_funBlock
 B m_md1Block(Block* bl, Scope* psc);
 B m_md2Block(Block* bl, Scope* psc);
+B funBl_c1(B t,      B x); // c1/c2 of a FunBlock; consume w & x
+B funBl_c2(B t, B w, B x);
 
 
 
@@ -1,5 +1,6 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <pthread.h>
 #include "../../include/bqnffi.h"
 
 void do_nothing() { }
@@ -138,6 +139,62 @@ BQNV bindAdd(BQNV x) {
   return r;
 }
 
+static double callIn(bqn_instance* i, BQNV f, double x) {
+  bqn_enter(i);
+  BQNV xv = bqn_makeF64(x);
+  double r = bqn_toF64(bqn_call1(f, xv));
+  bqn_free(xv);
+  return r;
+}
+int32_t multiInstance() { // 1 if two new instances evaluate independently; also 1 in builds without MULTI_INSTANCE, where there are no instances to test
+  bqn_instance* outer = bqn_currentInstance();
+  if (outer == NULL) return 1;
+  bqn_instance* a = bqn_newInstance();
+  bqn_instance* b = bqn_newInstance();
+  if (bqn_currentInstance() != outer) return 0;
+  bqn_enter(a); BQNV fa = bqn_evalCStr("{𝕩+≠↕10}");
+  bqn_enter(b); BQNV fb = bqn_evalCStr("{𝕩×+´↕3}");
+  int ok = bqn_currentInstance() == b;
+  ok&= callIn(a, fa, 5) == 15; // fa was made in a, and a's heap is intact after evaluating in b
+  ok&= callIn(b, fb, 5) == 15;
+  ok&= callIn(a, fa, 1) == 11;
+  bqn_enter(a); bqn_free(fa);
+  bqn_enter(b); bqn_free(fb);
+  bqn_enter(outer);
+  bqn_freeInstance(a);
+  bqn_freeInstance(b);
+  return ok && bqn_currentInstance() == outer;
+}
+
+static void* instanceThread(void* arg) {
+  int ok = multiInstance();
+  bqn_init(); // the thread's own default instance
+  bqn_instance* home = bqn_currentInstance();
+  BQNV f = bqn_evalCStr("{+´𝕩×↕1000}");
+  for (int i = 0; i < 100; i++) {
+    bqn_instance* a = bqn_newInstance();
+    bqn_enter(a);
+    BQNV fa = bqn_evalCStr("{𝕩-˜+´↕100}");
+    ok&= callIn(a, fa, i) == 4950-i;
+    bqn_free(fa);
+    ok&= callIn(home, f, i) == 499500.0*i;
+    bqn_freeInstance(a);
+  }
+  bqn_free(f);
+  *(int*)arg = ok;
+  return NULL;
+}
+int32_t multiThread() { // 1 if instances on several threads evaluate concurrently without interfering
+  if (bqn_currentInstance() == NULL) return 1;
+  enum { N = 8 };
+  pthread_t ts[N];
+  int oks[N];
+  for (int i = 0; i < N; i++) if (pthread_create(&ts[i], NULL, instanceThread, &oks[i])) return 0;
+  int ok = 1;
+  for (int i = 0; i < N; i++) { pthread_join(ts[i], NULL); ok&= oks[i]; }
+  return ok;
+}
+
 void printArgs(int8_t i8, int16_t i16, int32_t i32, uint8_t u8, uint16_t u16, uint32_t u32, float f, double d) {
   printf("args: %d %d %d %u %u %u %.18f %.18f\n", i8, i16, i32, u8, u16, u32, f, d);
 }
@@ -3,6 +3,7 @@ if [ "$#" -ne 1 ]; then
   echo "Usage: $0 path/to/mlochbaum/BQN"
   exit
 fi
+cases='cells ffi fills gc hash imports patterns perf prims syntax system test_range under undo' # test/cases/ that aren't specific to a configuration
 make                                    && ./BQN -p 2+2                || exit
 make single-debug                       && ./BQN -p 2+2                || exit
 make heapverify                         && ./BQN -p 2+2                || exit
@@ -23,13 +24,17 @@ build/build f='-DFORMATTER=0'         c && ./BQN -p 2+2 || exit
 build/build f='-DFFI_CHECKS=0'        c && ./BQN -p 2+2 || exit
 build/build f='-DDONT_FREE'           c && ./BQN -p 2+2 || exit
 build/build f='-DOBJ_COUNTER'         c && ./BQN -p 2+2 || exit
+build/build f='-DALLOC_SITES'         c && ./BQN test/run.bqn allocSites || exit
 build/build f='-DNO_RT'               c && ./BQN -p 2+2 || exit
-build/build f='-DNATIVE_COMPILER'     c && ./BQN -p 2+2 || exit
+build/build f='-DNATIVE_COMPILER'     c && ./BQN -p 2+2 && ./BQN test/nativeComp.bqn && ./BQN test/run.bqn $cases && ./BQN test/run.bqn full-comp $cases || exit
 build/build f='-DNATIVE_COMPILER -DONLY_NATIVE_COMP -DFORMATTER=0 -DNO_RT -DNO_EXPLAIN' c && ./BQN -p 2+2 || exit
 build/build f='-DGC_LOG_DETAILED'     c && ./BQN -p 2+2 || exit
 build/build f='-DUSE_PERF'            c && ./BQN -p 2+2 || exit
 build/build f='-DREPL_INTERRUPT=0'    c && ./BQN -p 2+2 || exit
 build/build f='-DREPL_INTERRUPT=1'    c && ./BQN -p 2+2 || exit
 build/build FFI=0                     c && ./BQN -p 2+2 || exit
+build/build f='-DMULTI_INSTANCE'      c && ./BQN -p 2+2 && make -C test/ffi testLib || exit
+build/build f='-DPARALLEL'            c && ./BQN -p 2+2 && ./BQN test/run.bqn cells || exit
+build/build f='-DHEAP_IMAGE' pie=0    c && ./BQN --write-image BQN.img && [ "$(CBQN_IMAGE=BQN.img ./BQN -p 2+2 2>&1)" = 4 ] && rm BQN.img || exit
 build/obj2/for_build4 test/precompiled.bqn "$1" "$PATH" '2+2' || exit
 build/build f='-DNO_RT -DPRECOMP'     c && ./BQN        || exit